@@ -3,7 +3,10 @@
 #include <stdio.h>
 #include <deque>
 #include <set>
+#include <map>
+#include <string>
 #include <cstdlib>
+#include <ctime>
 
 #ifdef WIN32
 #include "direct.h"
@@ -47,6 +50,7 @@ uint16 *LiqType;
 char output_path[128] = ".";
 char input_path[128] = ".";
 uint32 maxAreaId = 0;
+uint32 maxLiqTypeId = 0;
 
 //**************************************************
 // Extractor options
@@ -70,6 +74,9 @@ float CONF_float_to_int16_limit = 2048.0f;   // Max accuracy = val/65536
 float CONF_flat_height_delta_limit = 0.005f; // If max - min less this value - surface is flat
 float CONF_flat_liquid_delta_limit = 0.001f; // If max - min less this value - liquid surface is flat
 
+// This option allow skip convert of .adt files not changed from previous extraction
+bool  CONF_incremental = true;
+
 // List MPQ for extract from
 char *CONF_mpq_list[]={
     "common.MPQ",
@@ -116,6 +123,7 @@ void Usage(char* prg)
         "-o set output path\n"\
         "-e extract only MAP(1)/DBC(2) - standard: both(3)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
+        "-r rebuild all map files, also not changed from previous extraction 0 by default\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"", prg, prg);
     exit(1);
 }
@@ -129,6 +137,7 @@ void HandleArgs(int argc, char * arg[])
         // e - extract only MAP(1)/DBC(2) - standard both(3)
         // f - use float to int conversion
         // h - limit minimum height
+        // r - rebuild not changed map files
         if(arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -152,6 +161,12 @@ void HandleArgs(int argc, char * arg[])
                 else
                     Usage(arg[0]);
                 break;
+            case 'r':
+                if(c + 1 < argc)                            // all ok
+                    CONF_incremental=atoi(arg[(c++) + 1])==0;
+                else
+                    Usage(arg[0]);
+                break;
             case 'e':
                 if(c + 1 < argc)                            // all ok
                 {
@@ -262,6 +277,7 @@ void ReadLiquidTypeTableDBC()
     size_t LiqType_count = dbc.getRecordCount();
     size_t LiqType_maxid = dbc.getMaxId();
     LiqType = new uint16[LiqType_maxid + 1];
+    maxLiqTypeId = LiqType_maxid;
     memset(LiqType, 0xff, (LiqType_maxid + 1) * sizeof(uint16));
 
     for(uint32 x = 0; x < LiqType_count; ++x)
@@ -281,6 +297,86 @@ static char const* MAP_AREA_MAGIC    = "AREA";
 static char const* MAP_HEIGHT_MAGIC  = "MHGT";
 static char const* MAP_LIQUID_MAGIC  = "MLIQ";
 
+//
+// Content hashes for incremental extraction
+//
+
+typedef std::map<std::string, uint64> HashMap;
+HashMap prevMapHashes;                                      // loaded from previous extraction
+HashMap newMapHashes;                                       // saved after current extraction
+uint64 settingsHash = 0;                                    // build, options and dbc data used in convert
+
+#define MAP_HASHES_FILE "extractor_hashes.txt"
+
+// FNV-1a, 64 bit constants built from halves for old compilers
+uint64 HashData(uint64 hash, void const* data, size_t size)
+{
+    uint64 const prime = (uint64(0x00000100) << 32) | uint64(0x000001b3);
+    uint8 const* bytes = (uint8 const*)data;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= prime;
+    }
+    return hash;
+}
+
+uint64 CalculateSettingsHash(uint32 build)
+{
+    uint64 hash = (uint64(0xcbf29ce4) << 32) | uint64(0x84222325);
+    hash = HashData(hash, MAP_VERSION_MAGIC, 4);
+    hash = HashData(hash, &build, sizeof(build));
+    hash = HashData(hash, &CONF_allow_height_limit, sizeof(CONF_allow_height_limit));
+    hash = HashData(hash, &CONF_use_minHeight, sizeof(CONF_use_minHeight));
+    hash = HashData(hash, &CONF_allow_float_to_int, sizeof(CONF_allow_float_to_int));
+    hash = HashData(hash, &CONF_float_to_int8_limit, sizeof(CONF_float_to_int8_limit));
+    hash = HashData(hash, &CONF_float_to_int16_limit, sizeof(CONF_float_to_int16_limit));
+    hash = HashData(hash, &CONF_flat_height_delta_limit, sizeof(CONF_flat_height_delta_limit));
+    hash = HashData(hash, &CONF_flat_liquid_delta_limit, sizeof(CONF_flat_liquid_delta_limit));
+    hash = HashData(hash, areas, (maxAreaId + 1) * sizeof(uint16));
+    hash = HashData(hash, LiqType, (maxLiqTypeId + 1) * sizeof(uint16));
+    return hash;
+}
+
+void LoadMapHashes(std::string const& path)
+{
+    prevMapHashes.clear();
+    if (!CONF_incremental)
+        return;
+
+    FILE *input = fopen((path + MAP_HASHES_FILE).c_str(), "rb");
+    if (!input)
+        return;
+
+    // line format: <hash hex> <map file name>
+    char line[256];
+    while (fgets(line, sizeof(line), input))
+    {
+        uint32 hi, lo;
+        char name[128];
+        if (sscanf(line, "%8x%8x %127s", &hi, &lo, name) == 3)
+            prevMapHashes[name] = (uint64(hi) << 32) | uint64(lo);
+    }
+    fclose(input);
+
+    printf("Loaded %u hashes of previous extraction, unchanged maps will be skipped\n", uint32(prevMapHashes.size()));
+}
+
+void SaveMapHashes(std::string const& path)
+{
+    FILE *output = fopen((path + MAP_HASHES_FILE).c_str(), "wb");
+    if (!output)
+    {
+        printf("Can't create the output file '%s'\n", (path + MAP_HASHES_FILE).c_str());
+        return;
+    }
+
+    for (HashMap::const_iterator itr = newMapHashes.begin(); itr != newMapHashes.end(); ++itr)
+        fprintf(output, "%08x%08x %s\n", uint32(itr->second >> 32), uint32(itr->second), itr->first.c_str());
+
+    fclose(output);
+}
+
 struct map_fileheader
 {
     uint32 mapMagic;
@@ -363,13 +459,24 @@ uint8 liquid_type[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
 float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
 
-bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32 build)
+bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32 build, char const* hashKey, bool& skipped)
 {
     ADT_file adt;
 
+    skipped = false;
     if (!adt.loadFile(filename))
         return false;
 
+    // same source data and options, output must be same as already stored
+    uint64 hash = HashData(settingsHash, adt.GetData(), adt.GetDataSize());
+    HashMap::const_iterator prev = prevMapHashes.find(hashKey);
+    if (prev != prevMapHashes.end() && prev->second == hash && FileExists(filename2))
+    {
+        newMapHashes[hashKey] = hash;
+        skipped = true;
+        return true;
+    }
+
     adt_MCIN *cells = adt.a_grid->getMCIN();
     if (!cells)
     {
@@ -866,6 +973,8 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
     }
     fclose(output);
 
+    newMapHashes[hashKey] = hash;
+
     return true;
 }
 
@@ -874,8 +983,10 @@ void ExtractMapsFromMpq(uint32 build)
     char mpq_filename[1024];
     char output_filename[1024];
     char mpq_map_name[1024];
+    char hash_key[64];
 
     printf("Extracting maps...\n");
+    time_t startTime = time(NULL);
 
     uint32 map_count = ReadMapDBC();
 
@@ -886,6 +997,11 @@ void ExtractMapsFromMpq(uint32 build)
     path += "/maps/";
     CreateDir(path);
 
+    settingsHash = CalculateSettingsHash(build);
+    LoadMapHashes(path);
+
+    uint32 converted = 0, unchanged = 0, failed = 0;
+
     printf("Convert map files\n");
     for(uint32 z = 0; z < map_count; ++z)
     {
@@ -907,12 +1023,25 @@ void ExtractMapsFromMpq(uint32 build)
                     continue;
                 sprintf(mpq_filename, "World\\Maps\\%s\\%s_%u_%u.adt", map_ids[z].name, map_ids[z].name, x, y);
                 sprintf(output_filename, "%s/maps/%03u%02u%02u.map", output_path, map_ids[z].id, y, x);
-                ConvertADT(mpq_filename, output_filename, y, x, build);
+                sprintf(hash_key, "%03u%02u%02u.map", map_ids[z].id, y, x);
+                bool skipped;
+                if (!ConvertADT(mpq_filename, output_filename, y, x, build, hash_key, skipped))
+                    ++failed;
+                else if (skipped)
+                    ++unchanged;
+                else
+                    ++converted;
             }
             // draw progress bar
             printf("Processing........................%d%%\r", (100 * (y+1)) / WDT_MAP_SIZE);
         }
     }
+
+    // only successfully stored files, failed will be converted at next run
+    SaveMapHashes(path);
+
+    printf("Maps done: %u converted, %u unchanged, %u failed (%.0f sec)\n", converted, unchanged, failed, difftime(time(NULL), startTime));
+
     delete [] areas;
     delete [] map_ids;
 }
@@ -936,6 +1065,7 @@ bool ExtractFile( char const* mpq_name, std::string const& filename )
 void ExtractDBCFiles(int locale, bool basicLocale)
 {
     printf("Extracting dbc files...\n");
+    time_t startTime = time(NULL);
 
     std::set<std::string> dbcfiles;
 
@@ -977,7 +1107,7 @@ void ExtractDBCFiles(int locale, bool basicLocale)
         if(ExtractFile(iter->c_str(), filename))
             ++count;
     }
-    printf("Extracted %u DBC files\n\n", count);
+    printf("Extracted %u DBC files (%.0f sec)\n\n", count, difftime(time(NULL), startTime));
 }
 
 void LoadLocaleMPQFiles(int const locale)
@@ -0,0 +1,5 @@
+ALTER TABLE db_version CHANGE COLUMN required_10400_01_mangos_mangos_string required_10406_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('debug visibility');
+INSERT INTO command (name, security, help) VALUES
+('debug visibility',3,'Syntax: .debug visibility\r\n\r\nShow visibility statistic for your current map: visibility distance, camera visibility updates and object visibility checks done in last map update.');
@@ -0,0 +1,5 @@
+ALTER TABLE db_version CHANGE COLUMN required_10406_01_mangos_command required_10407_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('debug visibilityzones');
+INSERT INTO command (name, security, help) VALUES
+('debug visibilityzones',2,'Syntax: .debug visibilityzones\r\n\r\nShow effective (reduced in crowded regions) visibility distance for players in each zone of your current map.');
@@ -0,0 +1,5 @@
+ALTER TABLE db_version CHANGE COLUMN required_10407_01_mangos_command required_10408_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('debug pools');
+INSERT INTO command (name, security, help) VALUES
+('debug pools',3,'Syntax: .debug pools\r\n\r\nShow usage of pooled Spell, SpellAuraHolder and Aura allocators and allocation counts in last world tick.');
@@ -0,0 +1,5 @@
+ALTER TABLE db_version CHANGE COLUMN required_10408_01_mangos_command required_10409_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('debug querycache');
+INSERT INTO command (name, security, help) VALUES
+('debug querycache',3,'Syntax: .debug querycache\r\n\r\nShow count of cached query responses (creature, gameobject, item, quest, npc text, page text) and cache hits/misses since server start.');
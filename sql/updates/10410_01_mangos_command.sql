@@ -0,0 +1,5 @@
+ALTER TABLE db_version CHANGE COLUMN required_10409_01_mangos_command required_10410_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('debug pathfinder');
+INSERT INTO command (name, security, help) VALUES
+('debug pathfinder',3,'Syntax: .debug pathfinder\r\n\r\nShow path cache size, cache hits/misses since map creation, terrain nodes searched in last map update and count of paths replaced by direct movement because of PathFinding.MaxNodesPerTick limit for your current map.');
@@ -0,0 +1,5 @@
+ALTER TABLE db_version CHANGE COLUMN required_10410_01_mangos_command required_10411_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('debug auctionsearch');
+INSERT INTO command (name, security, help) VALUES
+('debug auctionsearch',3,'Syntax: .debug auctionsearch [#class [#quality [#levelmin [#levelmax [$itemname]]]]]\r\n\r\nRun auction list search in your faction auction house 100 times by full auction scan and 100 times by auction indexes, and show found auction counts and time spent by each way. Use -1 for any class or quality and 0 for any level.');
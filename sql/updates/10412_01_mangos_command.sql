@@ -0,0 +1,5 @@
+ALTER TABLE db_version CHANGE COLUMN required_10411_01_mangos_command required_10412_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('debug unitsearch');
+INSERT INTO command (name, security, help) VALUES
+('debug unitsearch',3,'Syntax: .debug unitsearch [#radius]\r\n\r\nSearch alive units in #radius (default 5) around you 1000 times by grid cells visit and 1000 times by map unit spatial index, and show found unit counts and time spent by each way.');
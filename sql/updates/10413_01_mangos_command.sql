@@ -0,0 +1,3 @@
+ALTER TABLE db_version CHANGE COLUMN required_10412_01_mangos_command required_10413_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('debug unitsearch');
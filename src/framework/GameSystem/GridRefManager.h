@@ -19,30 +19,205 @@
 #ifndef _GRIDREFMANAGER
 #define _GRIDREFMANAGER
 
-#include "Utilities/LinkedReference/RefManager.h"
-
-template<class OBJECT> class GridReference;
+#include "Common.h"
+#include "GameSystem/GridReference.h"
+#include <vector>
 
+/**
+ * Storage of objects in one grid cell (or of loaded grids in map).
+ *
+ * Objects kept in a dense array together with their handles, so visitors walk
+ * a continuous memory block instead of linked list nodes spread over the heap.
+ * Remove moves the last element into the freed place (swap-remove) and updates its handle.
+ *
+ * While any iterator of the manager exists, remove only marks the element as removed
+ * (iterators skip such elements) and array compacted with order kept at destroy of last iterator.
+ * So in iteration any element can be removed, no element visited twice or skipped.
+ * New elements appended after iteration position, not visited in current pass, same as for old list.
+ */
 template<class OBJECT>
-class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
+class GridRefManager
 {
     public:
 
-        typedef LinkedListHead::Iterator< GridReference<OBJECT> > iterator;
+        class GridRefEntry
+        {
+            public:
+                OBJECT* getSource() const { return i_source; }
+
+            private:
+                friend class GridRefManager<OBJECT>;
+
+                OBJECT* i_source;
+                GridReference<OBJECT>* i_reference;
+        };
+
+        typedef std::vector<GridRefEntry> GridRefStorage;
+
+        class iterator
+        {
+            public:
+
+                iterator() : i_manager(NULL), i_pos(0) {}
+                iterator(iterator const& other) : i_manager(other.i_manager), i_pos(other.i_pos) { attach(); }
+                ~iterator() { detach(); }
+
+                iterator& operator=(iterator const& other)
+                {
+                    if (i_manager != other.i_manager)
+                    {
+                        detach();
+                        i_manager = other.i_manager;
+                        attach();
+                    }
+                    i_pos = other.i_pos;
+                    return *this;
+                }
+
+                GridRefEntry* operator->() const { return &i_manager->i_elements[i_pos - 1]; }
+                GridRefEntry& operator*() const { return i_manager->i_elements[i_pos - 1]; }
+
+                iterator& operator++()
+                {
+                    --i_pos;
+                    skipRemoved();
+                    return *this;
+                }
+
+                bool operator==(iterator const& other) const { return i_pos == other.i_pos; }
+                bool operator!=(iterator const& other) const { return i_pos != other.i_pos; }
+
+            private:
+
+                friend class GridRefManager<OBJECT>;
+
+                iterator(GridRefManager<OBJECT>* manager, uint32 pos) : i_manager(manager), i_pos(pos) { attach(); skipRemoved(); }
+
+                void attach()
+                {
+                    if (i_manager)
+                        ++i_manager->i_iterators;
+                }
+
+                void detach()
+                {
+                    if (i_manager && --i_manager->i_iterators == 0 && i_manager->i_removed)
+                        i_manager->compact();
+                }
+
+                void skipRemoved()
+                {
+                    while (i_pos && !i_manager->i_elements[i_pos - 1].i_reference)
+                        --i_pos;
+                }
+
+                GridRefManager<OBJECT>* i_manager;
+                uint32 i_pos;                               // index of current element + 1, 0 for end
+        };
+
+        GridRefManager() : i_iterators(0), i_removed(0) {}
+        ~GridRefManager() { clearReferences(); }
 
+        // first and last in iteration order
         GridReference<OBJECT>* getFirst()
         {
-            return (GridReference<OBJECT>*)RefManager<GridRefManager<OBJECT>, OBJECT>::getFirst();
+            for (typename GridRefStorage::reverse_iterator itr = i_elements.rbegin(); itr != i_elements.rend(); ++itr)
+                if (itr->i_reference)
+                    return itr->i_reference;
+            return NULL;
         }
 
         GridReference<OBJECT>* getLast()
         {
-            return (GridReference<OBJECT>*)RefManager<GridRefManager<OBJECT>, OBJECT>::getLast();
+            for (typename GridRefStorage::iterator itr = i_elements.begin(); itr != i_elements.end(); ++itr)
+                if (itr->i_reference)
+                    return itr->i_reference;
+            return NULL;
+        }
+
+        iterator begin() { return iterator(this, uint32(i_elements.size())); }
+        iterator end() { return iterator(this, 0); }
+
+        uint32 getSize() const { return uint32(i_elements.size()) - i_removed; }
+        bool isEmpty() const { return getSize() == 0; }
+
+        void clearReferences()
+        {
+            for (typename GridRefStorage::iterator itr = i_elements.begin(); itr != i_elements.end(); ++itr)
+                if (itr->i_reference)
+                    itr->i_reference->i_manager = NULL;
+
+            i_elements.clear();
+            i_removed = 0;
+        }
+
+    private:
+
+        friend class GridReference<OBJECT>;
+        friend class iterator;
+
+        // called from GridReference::link
+        void insertReference(GridReference<OBJECT>* ref, OBJECT* obj)
+        {
+            ref->i_manager = this;
+            ref->i_source = obj;
+            ref->i_index = uint32(i_elements.size());
+
+            GridRefEntry entry;
+            entry.i_source = obj;
+            entry.i_reference = ref;
+            i_elements.push_back(entry);
+        }
+
+        // called from GridReference::unlink
+        void removeReference(GridReference<OBJECT>* ref)
+        {
+            uint32 index = ref->i_index;
+            ASSERT(index < i_elements.size() && i_elements[index].i_reference == ref);
+
+            ref->i_manager = NULL;
+            ref->i_source = NULL;
+
+            // in iteration only mark, moving element can make it visited twice or skipped
+            if (i_iterators)
+            {
+                i_elements[index].i_source = NULL;
+                i_elements[index].i_reference = NULL;
+                ++i_removed;
+                return;
+            }
+
+            if (index + 1 < i_elements.size())
+            {
+                i_elements[index] = i_elements.back();
+                i_elements[index].i_reference->i_index = index;
+            }
+            i_elements.pop_back();
+        }
+
+        // remove marked elements, called when last iterator destroyed
+        void compact()
+        {
+            uint32 dest = 0;
+            for (uint32 i = 0; i < i_elements.size(); ++i)
+            {
+                if (!i_elements[i].i_reference)
+                    continue;
+
+                if (dest != i)
+                {
+                    i_elements[dest] = i_elements[i];
+                    i_elements[dest].i_reference->i_index = dest;
+                }
+                ++dest;
+            }
+
+            i_elements.resize(dest);
+            i_removed = 0;
         }
 
-        iterator begin() { return iterator(getFirst()); }
-        iterator end() { return iterator(NULL); }
-        iterator rbegin() { return iterator(getLast()); }
-        iterator rend() { return iterator(NULL); }
+        GridRefStorage i_elements;
+        uint32 i_iterators;                                 // existing iterators, remove only marks elements if not 0
+        uint32 i_removed;                                   // marked as removed elements
 };
 #endif
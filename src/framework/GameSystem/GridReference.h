@@ -19,51 +19,65 @@
 #ifndef _GRIDREFERENCE_H
 #define _GRIDREFERENCE_H
 
-#include "Utilities/LinkedReference/Reference.h"
+#include "Common.h"
 
 template<class OBJECT> class GridRefManager;
 
+/**
+ * Handle of object stored in a GridRefManager.
+ *
+ * Remembers position of the object in manager storage, so unlink is done without search.
+ * The position is updated by the manager when another object is moved in place of a removed one.
+ */
 template<class OBJECT>
-class MANGOS_DLL_SPEC GridReference : public Reference<GridRefManager<OBJECT>, OBJECT>
+class MANGOS_DLL_SPEC GridReference
 {
-    protected:
+    public:
 
-        void targetObjectBuildLink()
+        GridReference()
+            : i_manager(NULL), i_source(NULL), i_index(0)
         {
-            // called from link()
-            this->getTarget()->insertFirst(this);
-            this->getTarget()->incSize();
         }
 
-        void targetObjectDestroyLink()
+        ~GridReference()
         {
-            // called from unlink()
-            if (this->isValid())
-                this->getTarget()->decSize();
+            this->unlink();
         }
 
-        void sourceObjectDestroyLink()
+        void link(GridRefManager<OBJECT>* toObj, OBJECT* fromObj)
         {
-            // called from invalidate()
-            this->getTarget()->decSize();
-        }
-
-    public:
+            ASSERT(fromObj);                                // fromObj MUST not be NULL
+            if (isValid())
+                unlink();
 
-        GridReference()
-            : Reference<GridRefManager<OBJECT>, OBJECT>()
-        {
+            if (toObj != NULL)
+                toObj->insertReference(this, fromObj);
         }
 
-        ~GridReference()
+        void unlink()
         {
-            this->unlink();
+            if (isValid())
+                i_manager->removeReference(this);
         }
 
-        GridReference *next()
-        {
-            return (GridReference*)Reference<GridRefManager<OBJECT>, OBJECT>::next();
-        }
+        bool isValid() const { return i_manager != NULL; }
+
+        GridRefManager<OBJECT>* getTarget() const { return i_manager; }
+        OBJECT* getSource() const { return i_source; }
+
+    private:
+
+        friend class GridRefManager<OBJECT>;
+
+        // position in manager storage can't be shared
+        GridReference(GridReference const&);
+        GridReference& operator=(GridReference const&);
+
+        GridRefManager<OBJECT>* i_manager;
+        OBJECT* i_source;
+        uint32 i_index;
 };
 
+#include "GameSystem/GridRefManager.h"
+
 #endif
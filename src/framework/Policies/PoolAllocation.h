@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2005-2010 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_POOLALLOCATION_H
+#define MANGOS_POOLALLOCATION_H
+
+#include "Platform/Define.h"
+#include <new>
+
+namespace MaNGOS
+{
+    struct PoolAllocationStats
+    {
+        PoolAllocationStats() : inUse(0), freeCount(0), chunks(0), tickAllocs(0), tickHeapAllocs(0), lastTickAllocs(0), lastTickHeapAllocs(0) {}
+
+        uint32 inUse;                                       // pooled objects currently allocated
+        uint32 freeCount;                                   // pooled blocks ready for reuse
+        uint32 chunks;                                      // chunks allocated from heap, never released
+        uint32 tickAllocs;                                  // all allocations in current tick
+        uint32 tickHeapAllocs;                              // allocations in current tick that used heap (new chunk or derived class)
+        uint32 lastTickAllocs;
+        uint32 lastTickHeapAllocs;
+    };
+
+    /**
+     * PoolAllocation base class replace operator new/delete of T by free list of
+     * fixed size blocks, allocated from heap by chunks of CHUNK_SIZE blocks and reused.
+     * Derived classes of other size use global operator new/delete.
+     * Not thread safe: for objects created and deleted in world update thread only.
+     */
+    template<class T, uint32 CHUNK_SIZE = 128>
+    class MANGOS_DLL_DECL PoolAllocation
+    {
+        public:
+
+            static void* operator new(size_t size)
+            {
+                PoolState& pool = GetPoolState();
+                ++pool.stats.tickAllocs;
+
+                if (size != sizeof(T))
+                {
+                    ++pool.stats.tickHeapAllocs;
+                    return ::operator new(size);
+                }
+
+                if (!pool.freeList)
+                {
+                    ++pool.stats.tickHeapAllocs;
+                    AllocateChunk(pool);
+                }
+
+                FreeBlock* block = pool.freeList;
+                pool.freeList = block->next;
+                --pool.stats.freeCount;
+                ++pool.stats.inUse;
+                return block;
+            }
+
+            static void operator delete(void* ptr, size_t size)
+            {
+                if (!ptr)
+                    return;
+
+                if (size != sizeof(T))
+                {
+                    ::operator delete(ptr);
+                    return;
+                }
+
+                PoolState& pool = GetPoolState();
+                FreeBlock* block = static_cast<FreeBlock*>(ptr);
+                block->next = pool.freeList;
+                pool.freeList = block;
+                ++pool.stats.freeCount;
+                --pool.stats.inUse;
+            }
+
+            static PoolAllocationStats const& GetPoolStats() { return GetPoolState().stats; }
+
+            // called once per world tick for per tick counters
+            static void NextPoolTick()
+            {
+                PoolAllocationStats& stats = GetPoolState().stats;
+                stats.lastTickAllocs = stats.tickAllocs;
+                stats.lastTickHeapAllocs = stats.tickHeapAllocs;
+                stats.tickAllocs = 0;
+                stats.tickHeapAllocs = 0;
+            }
+
+        private:
+
+            struct FreeBlock
+            {
+                FreeBlock* next;
+            };
+
+            struct PoolState
+            {
+                PoolState() : freeList(NULL) {}
+
+                FreeBlock* freeList;
+                PoolAllocationStats stats;
+            };
+
+            static size_t BlockSize()
+            {
+                return sizeof(T) > sizeof(FreeBlock) ? sizeof(T) : sizeof(FreeBlock);
+            }
+
+            static PoolState& GetPoolState()
+            {
+                static PoolState si_pool;
+                return si_pool;
+            }
+
+            static void AllocateChunk(PoolState& pool)
+            {
+                char* chunk = static_cast<char*>(::operator new(BlockSize() * CHUNK_SIZE));
+                for (uint32 i = 0; i < CHUNK_SIZE; ++i)
+                {
+                    FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * BlockSize());
+                    block->next = pool.freeList;
+                    pool.freeList = block;
+                }
+
+                ++pool.stats.chunks;
+                pool.stats.freeCount += CHUNK_SIZE;
+            }
+    };
+}
+
+#endif
@@ -21,6 +21,7 @@
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_events = NULL;
     m_aborting = false;
 }
 
@@ -35,12 +36,12 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (m_events && m_events->m_execTime <= m_time)
     {
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        BasicEvent* Event = m_events;
+        m_events = Event->m_nextEvent;
+        Event->m_nextEvent = NULL;
 
         if (!Event->to_Abort)
         {
@@ -64,25 +65,19 @@ void EventProcessor::KillAllEvents(bool force)
     m_aborting = true;
 
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    BasicEvent** link = &m_events;
+    while (BasicEvent* Event = *link)
     {
-        EventList::iterator i_old = i;
-        ++i;
-
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+        Event->to_Abort = true;
+        Event->Abort(m_time);
+        if (force || Event->IsDeletable())
         {
-            delete i_old->second;
-
-            if (!force)                                      // need per-element cleanup
-                m_events.erase (i_old);
+            *link = Event->m_nextEvent;
+            delete Event;
         }
+        else                                                // keep in queue, will be deleted at later call
+            link = &Event->m_nextEvent;
     }
-
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -91,7 +86,14 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         Event->m_addTime = m_time;
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+
+    // after all events with not later time
+    BasicEvent** link = &m_events;
+    while (*link && (*link)->m_execTime <= e_time)
+        link = &(*link)->m_nextEvent;
+
+    Event->m_nextEvent = *link;
+    *link = Event;
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset)
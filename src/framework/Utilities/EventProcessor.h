@@ -21,8 +21,6 @@
 
 #include "Platform/Define.h"
 
-#include <map>
-
 // Note. All times are in milliseconds here.
 
 class BasicEvent
@@ -30,7 +28,7 @@ class BasicEvent
     public:
 
         BasicEvent()
-            : to_Abort(false)
+            : to_Abort(false), m_nextEvent(NULL)
         {
         }
 
@@ -53,9 +51,12 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
-};
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+    private:
+        friend class EventProcessor;
+
+        BasicEvent* m_nextEvent;                            // intrusive link in EventProcessor queue
+};
 
 class EventProcessor
 {
@@ -68,11 +69,15 @@ class EventProcessor
         void KillAllEvents(bool force);
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         uint64 CalculateTime(uint64 t_offset);
+        bool Empty() const { return !m_events; }
 
     protected:
 
         uint64 m_time;
-        EventList m_events;
+        // Events sorted by execution time (same time events in add order) in intrusive list:
+        // no allocation at AddEvent, Update check only first event. Per-unit queues are short,
+        // so insert walk is cheaper here than tree or timing wheel structures.
+        BasicEvent* m_events;
         bool m_aborting;
 };
 
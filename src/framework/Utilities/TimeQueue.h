@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2005-2010 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_TIMEQUEUE_H
+#define MANGOS_TIMEQUEUE_H
+
+#include <ctime>
+#include <queue>
+#include <vector>
+
+/**
+ * Min-heap of values by time. Owner not remove entries at value change,
+ * so popped entries must be validated against current state by caller.
+ */
+template<class T>
+class TimeQueue
+{
+    public:
+        struct Entry
+        {
+            Entry(time_t _time, T const& _value) : time(_time), value(_value) {}
+
+            bool operator>(Entry const& other) const { return time > other.time; }
+
+            time_t time;
+            T value;
+        };
+
+        bool empty() const { return m_queue.empty(); }
+        size_t size() const { return m_queue.size(); }
+
+        void push(time_t time, T const& value) { m_queue.push(Entry(time, value)); }
+        Entry const& top() const { return m_queue.top(); }
+        void pop() { m_queue.pop(); }
+
+    private:
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > m_queue;
+};
+
+#endif
@@ -111,14 +111,12 @@ bool ArenaTeam::AddMember(ObjectGuid playerGuid)
     }
     else
     {
-        //                                                     0     1
-        QueryResult *result = CharacterDatabase.PQuery("SELECT name, class FROM characters WHERE guid='%u'", playerGuid.GetCounter());
-        if (!result)
+        CharacterNameData const* nameData = sObjectMgr.GetCharacterNameData(playerGuid);
+        if (!nameData)
             return false;
 
-        plName = (*result)[0].GetCppString();
-        plClass = (*result)[1].GetUInt8();
-        delete result;
+        plName = nameData->name;
+        plClass = nameData->playerClass;
 
         // check if player already in arenateam of that size
         if (Player::GetArenaTeamIdFromDB(playerGuid, GetType()) != 0)
@@ -718,14 +716,20 @@ void ArenaTeam::UpdateArenaPointsHelper(std::map<uint32, uint32>& PlayerPoints)
 void ArenaTeam::SaveToDB()
 {
     // save team and member stats to db
-    // called after a match has ended, or when calculating arena_points
+    // called after a match has ended
     CharacterDatabase.BeginTransaction();
+    SaveStatsToDB();
+    CharacterDatabase.CommitTransaction();
+}
+
+void ArenaTeam::SaveStatsToDB()
+{
+    // caller must start transaction, used also for all teams saving in one transaction at arena points distribution
     CharacterDatabase.PExecute("UPDATE arena_team_stats SET rating = '%u',games = '%u',played = '%u',rank = '%u',wins = '%u',wins2 = '%u' WHERE arenateamid = '%u'", m_stats.rating, m_stats.games_week, m_stats.games_season, m_stats.rank, m_stats.wins_week, m_stats.wins_season, GetId());
     for(MemberList::const_iterator itr = m_members.begin(); itr !=  m_members.end(); ++itr)
     {
         CharacterDatabase.PExecute("UPDATE arena_team_member SET played_week = '%u', wons_week = '%u', played_season = '%u', wons_season = '%u', personal_rating = '%u' WHERE arenateamid = '%u' AND guid = '%u'", itr->games_week, itr->wins_week, itr->games_season, itr->wins_season, itr->personal_rating, m_TeamId, itr->guid.GetCounter());
     }
-    CharacterDatabase.CommitTransaction();
 }
 
 void ArenaTeam::FinishWeek()
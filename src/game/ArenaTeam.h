@@ -183,6 +183,7 @@ class ArenaTeam
         void LoadStatsFromDB(uint32 ArenaTeamId);
 
         void SaveToDB();
+        void SaveStatsToDB();                               // without own transaction
 
         void BroadcastPacket(WorldPacket *packet);
 
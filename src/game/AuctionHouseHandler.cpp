@@ -643,17 +643,24 @@ void WorldSession::HandleAuctionListItems( WorldPacket & recv_data )
     uint32 totalcount = 0;
     data << uint32(0);
 
+    AuctionListFilter filter;
+
     // converting string that we try to find to lower case
-    std::wstring wsearchedname;
-    if(!Utf8toWStr(searchedname,wsearchedname))
+    if(!Utf8toWStr(searchedname, filter.searchedname))
         return;
 
-    wstrToLower(wsearchedname);
+    wstrToLower(filter.searchedname);
+
+    filter.listfrom = listfrom;
+    filter.levelmin = levelmin;
+    filter.levelmax = levelmax;
+    filter.usable = usable;
+    filter.inventoryType = auctionSlotID;
+    filter.itemClass = auctionMainCategory;
+    filter.itemSubClass = auctionSubCategory;
+    filter.quality = quality;
 
-    auctionHouse->BuildListAuctionItems(data, _player,
-        wsearchedname, listfrom, levelmin, levelmax, usable,
-        auctionSlotID, auctionMainCategory, auctionSubCategory, quality,
-        count, totalcount);
+    auctionHouse->BuildListAuctionItems(data, _player, filter, count, totalcount);
 
     data.put<uint32>(0, count);
     data << uint32(totalcount);
@@ -39,6 +39,8 @@
 
 INSTANTIATE_SINGLETON_1( AuctionHouseMgr );
 
+#define AUCTION_DELETE_BATCH_SIZE  1000                     // max auction ids in one expired auctions delete statement
+
 AuctionHouseMgr::AuctionHouseMgr()
 {
 }
@@ -455,6 +457,35 @@ bool AuctionHouseMgr::RemoveAItem( uint32 id )
     return true;
 }
 
+std::wstring const& AuctionHouseMgr::GetSearchName(ItemPrototype const* proto, int loc_idx)
+{
+    uint64 key = (uint64(loc_idx + 1) << 32) | proto->ItemId;
+
+    SearchNameMap::const_iterator itr = mSearchNames.find(key);
+    if (itr != mSearchNames.end())
+        return itr->second;
+
+    std::string name = proto->Name1;
+
+    // local name
+    if (loc_idx >= 0)
+    {
+        if (ItemLocale const *il = sObjectMgr.GetItemLocale(proto->ItemId))
+        {
+            if (il->Name.size() > size_t(loc_idx) && !il->Name[loc_idx].empty())
+                name = il->Name[loc_idx];
+        }
+    }
+
+    std::wstring& wname = mSearchNames[key];
+    if (Utf8toWStr(name, wname))
+        wstrToLower(wname);
+    else
+        wname.clear();
+
+    return wname;
+}
+
 void AuctionHouseMgr::Update()
 {
     mHordeAuctions.Update();
@@ -542,36 +573,45 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(Unit* unit)
 void AuctionHouseObject::Update()
 {
     time_t curTime = sWorld.GetGameTime();
-    ///- Handle expired auctions
-    AuctionEntryMap::iterator next;
-    for (AuctionEntryMap::iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end();itr = next)
+
+    std::vector<uint32> expiredIds;
+
+    ///- Handle expired auctions, only due entries of expire queue checked
+    while (!AuctionsExpireQueue.empty() && curTime > AuctionsExpireQueue.top().time)
     {
-        next = itr;
-        ++next;
-        if (curTime > (itr->second->expire_time))
-        {
-            ///- Either cancel the auction if there was no bidder
-            if (itr->second->bidder == 0)
-            {
-                sAuctionMgr.SendAuctionExpiredMail( itr->second );
-            }
-            ///- Or perform the transaction
-            else
-            {
-                //we should send an "item sold" message if the seller is online
-                //we send the item to the winner
-                //we send the money to the seller
-                sAuctionMgr.SendAuctionSuccessfulMail( itr->second );
-                sAuctionMgr.SendAuctionWonMail( itr->second );
-            }
+        ExpireQueue::Entry entry = AuctionsExpireQueue.top();
+        AuctionsExpireQueue.pop();
 
-            ///- In any case clear the auction
-            itr->second->DeleteFromDB();
-            sAuctionMgr.RemoveAItem(itr->second->item_guidlow);
-            delete itr->second;
-            RemoveAuction(itr->first);
+        AuctionEntryMap::iterator itr = AuctionsMap.find(entry.value);
+        if (itr == AuctionsMap.end() || itr->second->expire_time != entry.time)
+            continue;
+
+        AuctionEntry* auction = itr->second;
+
+        ///- Either cancel the auction if there was no bidder
+        if (auction->bidder == 0)
+        {
+            sAuctionMgr.SendAuctionExpiredMail( auction );
+        }
+        ///- Or perform the transaction
+        else
+        {
+            //we should send an "item sold" message if the seller is online
+            //we send the item to the winner
+            //we send the money to the seller
+            sAuctionMgr.SendAuctionSuccessfulMail( auction );
+            sAuctionMgr.SendAuctionWonMail( auction );
         }
+
+        ///- In any case clear the auction
+        expiredIds.push_back(auction->Id);
+        sAuctionMgr.RemoveAItem(auction->item_guidlow);
+        RemoveAuction(auction->Id);
+        delete auction;
     }
+
+    ///- Expired auctions deleted from DB by few statements instead statement per auction
+    CharacterDatabase.ExecuteIdList("DELETE FROM auction WHERE id IN (", expiredIds, ")", AUCTION_DELETE_BATCH_SIZE);
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
@@ -602,62 +642,171 @@ void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player,
     }
 }
 
-void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player,
-    std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin, uint32 levelmax, uint32 usable,
-    uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
-    uint32& count, uint32& totalcount)
+void AuctionHouseObject::AddAuction(AuctionEntry *ah)
+{
+    ASSERT( ah );
+    AuctionsMap[ah->Id] = ah;
+    AuctionsExpireQueue.push(ah->expire_time, ah->Id);
+
+    if (ItemPrototype const* proto = ObjectMgr::GetItemPrototype(ah->item_template))
+    {
+        AddToIndex(AuctionsByClass, MakeClassKey(proto->Class, proto->SubClass), ah);
+        AddToIndex(AuctionsByQuality, proto->Quality, ah);
+        AddToIndex(AuctionsByLevel, proto->RequiredLevel, ah);
+        AddToIndex(AuctionsByEntry, proto->ItemId, ah);
+    }
+}
+
+bool AuctionHouseObject::RemoveAuction(uint32 id)
 {
+    AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+    if (itr == AuctionsMap.end())
+        return false;
+
+    if (ItemPrototype const* proto = ObjectMgr::GetItemPrototype(itr->second->item_template))
+    {
+        RemoveFromIndex(AuctionsByClass, MakeClassKey(proto->Class, proto->SubClass), id);
+        RemoveFromIndex(AuctionsByQuality, proto->Quality, id);
+        RemoveFromIndex(AuctionsByLevel, proto->RequiredLevel, id);
+        RemoveFromIndex(AuctionsByEntry, proto->ItemId, id);
+    }
+
+    AuctionsMap.erase(itr);
+    return true;
+}
+
+void AuctionHouseObject::AddToIndex(AuctionIndex& index, uint32 key, AuctionEntry* auction)
+{
+    index[key][auction->Id] = auction;
+}
+
+void AuctionHouseObject::RemoveFromIndex(AuctionIndex& index, uint32 key, uint32 id)
+{
+    AuctionIndex::iterator itr = index.find(key);
+    if (itr == index.end())
+        return;
+
+    itr->second.erase(id);
+    if (itr->second.empty())
+        index.erase(itr);
+}
+
+void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player, AuctionListFilter const& filter, uint32& count, uint32& totalcount)
+{
+    // wrong class from client, nothing can be found
+    if (filter.itemClass != 0xffffffff && (filter.itemClass >= MAX_ITEM_CLASS || (filter.itemSubClass != 0xffffffff && filter.itemSubClass > 0xffff)))
+        return;
+
+    // empty level range, nothing can be found
+    if (filter.levelmin != 0x00 && filter.levelmax != 0x00 && filter.levelmax < filter.levelmin)
+        return;
+
+    // index selected by fixed priority (not by current range sizes), so rows order, and so listfrom
+    // paging, not changed between page requests by added or expired auctions
+    AuctionIndex::const_iterator begin, end;
+    bool byEntry = false;
+
+    if (filter.itemClass != 0xffffffff)
+    {
+        if (filter.itemSubClass != 0xffffffff)
+        {
+            begin = AuctionsByClass.lower_bound(MakeClassKey(filter.itemClass, filter.itemSubClass));
+            end = AuctionsByClass.upper_bound(MakeClassKey(filter.itemClass, filter.itemSubClass));
+        }
+        else
+        {
+            begin = AuctionsByClass.lower_bound(MakeClassKey(filter.itemClass, 0));
+            end = AuctionsByClass.upper_bound(MakeClassKey(filter.itemClass, 0xffff));
+        }
+    }
+    else if (filter.levelmin != 0x00)
+    {
+        begin = AuctionsByLevel.lower_bound(filter.levelmin);
+        end = filter.levelmax != 0x00 ? AuctionsByLevel.upper_bound(filter.levelmax) : AuctionsByLevel.end();
+    }
+    else if (filter.quality != 0xffffffff)
+    {
+        begin = AuctionsByQuality.lower_bound(filter.quality);
+        end = AuctionsByQuality.upper_bound(filter.quality);
+    }
+    else
+    {
+        // without any index usable filter all auctions checked, but prototype filters only once per item entry
+        begin = AuctionsByEntry.begin();
+        end = AuctionsByEntry.end();
+        byEntry = true;
+    }
+
     int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
 
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin();itr != AuctionsMap.end();++itr)
+    for (AuctionIndex::const_iterator itr = begin; itr != end; ++itr)
     {
-        AuctionEntry *Aentry = itr->second;
-        Item *item = sAuctionMgr.GetAItem(Aentry->item_guidlow);
-        if (!item)
-            continue;
+        if (byEntry)
+        {
+            ItemPrototype const* proto = ObjectMgr::GetItemPrototype(itr->first);
+            if (!proto || !IsMatchingPrototype(proto, filter, loc_idx))
+                continue;
+        }
 
-        ItemPrototype const *proto = item->GetProto();
+        BuildListAuctionItems(itr->second, byEntry, data, player, filter, count, totalcount);
+    }
+}
 
-        if (itemClass != 0xffffffff && proto->Class != itemClass)
-            continue;
+bool AuctionHouseObject::IsMatchingPrototype(ItemPrototype const* proto, AuctionListFilter const& filter, int loc_idx)
+{
+    if (filter.itemClass != 0xffffffff && proto->Class != filter.itemClass)
+        return false;
 
-        if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-            continue;
+    if (filter.itemSubClass != 0xffffffff && proto->SubClass != filter.itemSubClass)
+        return false;
 
-        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-            continue;
+    if (filter.inventoryType != 0xffffffff && proto->InventoryType != filter.inventoryType)
+        return false;
 
-        if (quality != 0xffffffff && proto->Quality != quality)
-            continue;
+    if (filter.quality != 0xffffffff && proto->Quality != filter.quality)
+        return false;
 
-        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-            continue;
+    if (filter.levelmin != 0x00 && (proto->RequiredLevel < filter.levelmin || (filter.levelmax != 0x00 && proto->RequiredLevel > filter.levelmax)))
+        return false;
 
-        if (usable != 0x00 && player->CanUseItem( item ) != EQUIP_ERR_OK)
-            continue;
+    if (!proto->Name1 || !*proto->Name1)
+        return false;
 
-        std::string name = proto->Name1;
-        if(name.empty())
-            continue;
+    if (!filter.searchedname.empty() && sAuctionMgr.GetSearchName(proto, loc_idx).find(filter.searchedname) == std::wstring::npos)
+        return false;
+
+    return true;
+}
 
-        // local name
-        if ( loc_idx >= 0 )
+void AuctionHouseObject::BuildListAuctionItems(AuctionEntryMap const& auctions, bool protoChecked, WorldPacket& data, Player* player,
+    AuctionListFilter const& filter, uint32& count, uint32& totalcount)
+{
+    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
+
+    for (AuctionEntryMap::const_iterator itr = auctions.begin(); itr != auctions.end(); ++itr)
+    {
+        AuctionEntry *Aentry = itr->second;
+
+        // prototype filters checked before item lookup
+        if (!protoChecked)
         {
-            ItemLocale const *il = sObjectMgr.GetItemLocale(proto->ItemId);
-            if (il)
-            {
-                if (il->Name.size() > size_t(loc_idx) && !il->Name[loc_idx].empty())
-                    name = il->Name[loc_idx];
-            }
+            ItemPrototype const *proto = ObjectMgr::GetItemPrototype(Aentry->item_template);
+            if (!proto || !IsMatchingPrototype(proto, filter, loc_idx))
+                continue;
         }
 
-        if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname) )
+        // auctions with missing item skipped before paging, so total count match listed pages
+        Item *item = sAuctionMgr.GetAItem(Aentry->item_guidlow);
+        if (!item)
             continue;
 
-        if (count < 50 && totalcount >= listfrom)
+        if (filter.usable != 0x00 && player->CanUseItem( item ) != EQUIP_ERR_OK)
+            continue;
+
+        if (count < 50 && totalcount >= filter.listfrom)
         {
-            ++count;
             Aentry->BuildAuctionInfo(data);
+            ++count;
         }
         ++totalcount;
     }
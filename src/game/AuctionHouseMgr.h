@@ -22,7 +22,10 @@
 #include "SharedDefines.h"
 #include "Policies/Singleton.h"
 
+#include "Utilities/TimeQueue.h"
+
 class Item;
+struct ItemPrototype;
 class Player;
 class Unit;
 class WorldPacket;
@@ -69,6 +72,20 @@ struct AuctionEntry
     void SaveToDB() const;
 };
 
+// CMSG_AUCTION_LIST_ITEMS search filters, 0xffffffff (0 for levels and usable) mean not used
+struct AuctionListFilter
+{
+    std::wstring searchedname;                              // lower case
+    uint32 listfrom;
+    uint32 levelmin;
+    uint32 levelmax;
+    uint32 usable;
+    uint32 inventoryType;
+    uint32 itemClass;
+    uint32 itemSubClass;
+    uint32 quality;
+};
+
 //this class is used as auctionhouse instance
 class AuctionHouseObject
 {
@@ -84,11 +101,7 @@ class AuctionHouseObject
 
         uint32 Getcount() { return AuctionsMap.size(); }
 
-        void AddAuction(AuctionEntry *ah)
-        {
-            ASSERT( ah );
-            AuctionsMap[ah->Id] = ah;
-        }
+        void AddAuction(AuctionEntry *ah);
 
         AuctionEntry* GetAuction(uint32 id) const
         {
@@ -96,22 +109,37 @@ class AuctionHouseObject
             return itr != AuctionsMap.end() ? itr->second : NULL;
         }
 
-        bool RemoveAuction(uint32 id)
-        {
-            return AuctionsMap.erase(id) ? true : false;
-        }
+        bool RemoveAuction(uint32 id);
 
         void Update();
 
         void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
         void BuildListOwnerItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
-        void BuildListAuctionItems(WorldPacket& data, Player* player,
-            std::wstring const& searchedname, uint32 listfrom, uint32 levelmin, uint32 levelmax, uint32 usable,
-            uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
-            uint32& count, uint32& totalcount);
+        void BuildListAuctionItems(WorldPacket& data, Player* player, AuctionListFilter const& filter, uint32& count, uint32& totalcount);
 
     private:
+        // auctions grouped by some item prototype field, search walk only groups with wanted field values
+        typedef std::map<uint32, AuctionEntryMap> AuctionIndex;
+
+        static uint32 MakeClassKey(uint32 itemClass, uint32 itemSubClass) { return (itemClass << 16) | itemSubClass; }
+
+        static void AddToIndex(AuctionIndex& index, uint32 key, AuctionEntry* auction);
+        static void RemoveFromIndex(AuctionIndex& index, uint32 key, uint32 id);
+
+        static bool IsMatchingPrototype(ItemPrototype const* proto, AuctionListFilter const& filter, int loc_idx);
+        // protoChecked is true if all auctions have same already checked prototype
+        static void BuildListAuctionItems(AuctionEntryMap const& auctions, bool protoChecked, WorldPacket& data, Player* player,
+            AuctionListFilter const& filter, uint32& count, uint32& totalcount);
+
+        // auction ids by expire time, entries validated at processing (auction can be bought out or canceled already)
+        typedef TimeQueue<uint32> ExpireQueue;
+
         AuctionEntryMap AuctionsMap;
+        AuctionIndex AuctionsByClass;                       // by MakeClassKey(Class, SubClass)
+        AuctionIndex AuctionsByQuality;
+        AuctionIndex AuctionsByLevel;                       // by RequiredLevel, ordered for level range search
+        AuctionIndex AuctionsByEntry;                       // prototype filters checked once per item entry
+        ExpireQueue AuctionsExpireQueue;
 };
 
 class AuctionHouseMgr
@@ -121,6 +149,7 @@ class AuctionHouseMgr
         ~AuctionHouseMgr();
 
         typedef UNORDERED_MAP<uint32, Item*> ItemMap;
+        typedef UNORDERED_MAP<uint64, std::wstring> SearchNameMap;
 
         AuctionHouseObject* GetAuctionsMap(AuctionHouseEntry const* house);
 
@@ -134,6 +163,10 @@ class AuctionHouseMgr
             return NULL;
         }
 
+        // lower case item name in session db locale (-1 for default), cached for auction list search
+        std::wstring const& GetSearchName(ItemPrototype const* proto, int loc_idx);
+        void ClearSearchNames() { mSearchNames.clear(); }
+
         //auction messages
         void SendAuctionWonMail( AuctionEntry * auction );
         void SendAuctionSalePendingMail( AuctionEntry * auction );
@@ -160,6 +193,7 @@ class AuctionHouseMgr
         AuctionHouseObject  mNeutralAuctions;
 
         ItemMap             mAitems;
+        SearchNameMap       mSearchNames;
 };
 
 #define sAuctionMgr MaNGOS::Singleton<AuctionHouseMgr>::Instance()
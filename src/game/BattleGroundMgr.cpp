@@ -48,6 +48,8 @@
 
 INSTANTIATE_SINGLETON_1( BattleGroundMgr );
 
+#define ARENA_POINTS_UPDATE_BATCH_SIZE  1000                // max guids in one arena points update statement
+
 /*********************************************************/
 /***            BATTLEGROUND QUEUE SYSTEM              ***/
 /*********************************************************/
@@ -210,6 +212,8 @@ GroupQueueInfo * BattleGroundQueue::AddGroup(Player *leader, Group* grp, BattleG
 
         //add GroupInfo to m_QueuedGroups
         m_QueuedGroups[bracketId][index].push_back(ginfo);
+        if (isRated)
+            m_RatedGroups[bracketId][index].insert(RatedGroupsIndex::value_type(arenaRating, --m_QueuedGroups[bracketId][index].end()));
 
         //announce to world, this code needs mutex
         if (!ArenaType && !isRated && !isPremade && sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN))
@@ -394,6 +398,8 @@ void BattleGroundQueue::RemovePlayer(const uint64& guid, bool decreaseInvitedCou
     // remove group queue info if needed
     if (group->Players.empty())
     {
+        if (group->IsRated && !group->IsInvitedToBGInstanceGUID)
+            RemoveFromRatedIndex(BattleGroundBracketId(bracket_id), index, group);
         m_QueuedGroups[bracket_id][index].erase(group_itr);
         delete group;
     }
@@ -935,25 +941,15 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
         // we need to find 2 teams which will play next game
 
         GroupsQueueType::iterator itr_team[BG_TEAMS_COUNT];
+        uint32 queue_team[BG_TEAMS_COUNT];                  // queue of selected team, can be other faction queue
 
         //optimalization : --- we dont need to use selection_pools - each update we select max 2 groups
 
         for(uint32 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
         {
-            // take the group that joined first
-            itr_team[i] = m_QueuedGroups[bracket_id][i].begin();
-            for(; itr_team[i] != m_QueuedGroups[bracket_id][i].end(); ++(itr_team[i]))
-            {
-                // if group match conditions, then add it to pool
-                if( !(*itr_team[i])->IsInvitedToBGInstanceGUID
-                    && (((*itr_team[i])->ArenaTeamRating >= arenaMinRating && (*itr_team[i])->ArenaTeamRating <= arenaMaxRating)
-                        || (*itr_team[i])->JoinTime < discardTime) )
-                {
-                    m_SelectionPools[i].AddGroup((*itr_team[i]), MaxPlayersPerTeam);
-                    // break for cycle to be able to start selecting another group from same faction queue
-                    break;
-                }
-            }
+            queue_team[i] = i;
+            if (SelectRatedGroup(bracket_id, i, arenaRating, arenaMinRating, arenaMaxRating, discardTime, NULL, itr_team[i]))
+                m_SelectionPools[i].AddGroup((*itr_team[i]), MaxPlayersPerTeam);
         }
         // now we are done if we have 2 groups - ali vs horde!
         // if we don't have, we must try to continue search in same queue
@@ -961,36 +957,17 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
         // this code isn't much userfriendly - but it is supposed to continue search for mathing group in HORDE queue
         if (m_SelectionPools[BG_TEAM_ALLIANCE].GetPlayerCount() == 0 && m_SelectionPools[BG_TEAM_HORDE].GetPlayerCount())
         {
-            itr_team[BG_TEAM_ALLIANCE] = itr_team[BG_TEAM_HORDE];
-            ++itr_team[BG_TEAM_ALLIANCE];
-            for(; itr_team[BG_TEAM_ALLIANCE] != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].end(); ++(itr_team[BG_TEAM_ALLIANCE]))
-            {
-                if( !(*itr_team[BG_TEAM_ALLIANCE])->IsInvitedToBGInstanceGUID
-                    && (((*itr_team[BG_TEAM_ALLIANCE])->ArenaTeamRating >= arenaMinRating && (*itr_team[BG_TEAM_ALLIANCE])->ArenaTeamRating <= arenaMaxRating)
-                        || (*itr_team[BG_TEAM_ALLIANCE])->JoinTime < discardTime) )
-                {
-                    m_SelectionPools[BG_TEAM_ALLIANCE].AddGroup((*itr_team[BG_TEAM_ALLIANCE]), MaxPlayersPerTeam);
-                    break;
-                }
-            }
+            queue_team[BG_TEAM_ALLIANCE] = BG_QUEUE_PREMADE_HORDE;
+            if (SelectRatedGroup(bracket_id, BG_QUEUE_PREMADE_HORDE, arenaRating, arenaMinRating, arenaMaxRating, discardTime, *itr_team[BG_TEAM_HORDE], itr_team[BG_TEAM_ALLIANCE]))
+                m_SelectionPools[BG_TEAM_ALLIANCE].AddGroup((*itr_team[BG_TEAM_ALLIANCE]), MaxPlayersPerTeam);
         }
         // this code isn't much userfriendly - but it is supposed to continue search for mathing group in ALLIANCE queue
         if (m_SelectionPools[BG_TEAM_HORDE].GetPlayerCount() == 0 && m_SelectionPools[BG_TEAM_ALLIANCE].GetPlayerCount())
         {
-            itr_team[BG_TEAM_HORDE] = itr_team[BG_TEAM_ALLIANCE];
-            ++itr_team[BG_TEAM_HORDE];
-            for(; itr_team[BG_TEAM_HORDE] != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].end(); ++(itr_team[BG_TEAM_HORDE]))
-            {
-                if( !(*itr_team[BG_TEAM_HORDE])->IsInvitedToBGInstanceGUID
-                    && (((*itr_team[BG_TEAM_HORDE])->ArenaTeamRating >= arenaMinRating && (*itr_team[BG_TEAM_HORDE])->ArenaTeamRating <= arenaMaxRating)
-                        || (*itr_team[BG_TEAM_HORDE])->JoinTime < discardTime) )
-                {
-                    m_SelectionPools[BG_TEAM_HORDE].AddGroup((*itr_team[BG_TEAM_HORDE]), MaxPlayersPerTeam);
-                    break;
-                }
-            }
+            queue_team[BG_TEAM_HORDE] = BG_QUEUE_PREMADE_ALLIANCE;
+            if (SelectRatedGroup(bracket_id, BG_QUEUE_PREMADE_ALLIANCE, arenaRating, arenaMinRating, arenaMaxRating, discardTime, *itr_team[BG_TEAM_ALLIANCE], itr_team[BG_TEAM_HORDE]))
+                m_SelectionPools[BG_TEAM_HORDE].AddGroup((*itr_team[BG_TEAM_HORDE]), MaxPlayersPerTeam);
         }
-
         //if we have 2 teams, then start new arena and invite players!
         if (m_SelectionPools[BG_TEAM_ALLIANCE].GetPlayerCount() && m_SelectionPools[BG_TEAM_HORDE].GetPlayerCount())
         {
@@ -1001,6 +978,10 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
                 return;
             }
 
+            // selected teams not candidates anymore, remove before possible move to other faction queue
+            RemoveFromRatedIndex(bracket_id, queue_team[BG_TEAM_ALLIANCE], *itr_team[BG_TEAM_ALLIANCE]);
+            RemoveFromRatedIndex(bracket_id, queue_team[BG_TEAM_HORDE], *itr_team[BG_TEAM_HORDE]);
+
             (*(itr_team[BG_TEAM_ALLIANCE]))->OpponentsTeamRating = (*(itr_team[BG_TEAM_HORDE]))->ArenaTeamRating;
             DEBUG_LOG("setting oposite teamrating for team %u to %u", (*(itr_team[BG_TEAM_ALLIANCE]))->ArenaTeamId, (*(itr_team[BG_TEAM_ALLIANCE]))->OpponentsTeamRating);
             (*(itr_team[BG_TEAM_HORDE]))->OpponentsTeamRating = (*(itr_team[BG_TEAM_ALLIANCE]))->ArenaTeamRating;
@@ -1031,6 +1012,75 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
     }
 }
 
+// select rated arena team from premade queue to play against team with arenaRating:
+// first not invited team if it waits longer than rating discard time, else team with closest rating in range
+bool BattleGroundQueue::SelectRatedGroup(BattleGroundBracketId bracket_id, uint32 queue, uint32 arenaRating, uint32 minRating, uint32 maxRating,
+    uint32 discardTime, GroupQueueInfo const* exclude, GroupsQueueType::iterator& result)
+{
+    // queue in join order, invited teams stay in it until enter arena
+    for (GroupsQueueType::iterator itr = m_QueuedGroups[bracket_id][queue].begin(); itr != m_QueuedGroups[bracket_id][queue].end(); ++itr)
+    {
+        if ((*itr)->IsInvitedToBGInstanceGUID || *itr == exclude)
+            continue;
+
+        if ((*itr)->JoinTime < discardTime)
+        {
+            result = itr;
+            return true;
+        }
+        break;
+    }
+
+    RatedGroupsIndex& ratings = m_RatedGroups[bracket_id][queue];
+
+    RatedGroupsIndex::iterator higher = ratings.lower_bound(arenaRating);
+    while (higher != ratings.end() && *higher->second == exclude)
+        ++higher;
+
+    RatedGroupsIndex::iterator lower = ratings.lower_bound(arenaRating);
+    bool hasLower = false;
+    while (lower != ratings.begin())
+    {
+        --lower;
+        if (*lower->second != exclude)
+        {
+            hasLower = true;
+            break;
+        }
+    }
+
+    bool useHigher = higher != ratings.end() && higher->first <= maxRating;
+    bool useLower = hasLower && lower->first >= minRating;
+    if (useHigher && useLower)
+    {
+        if (higher->first - arenaRating <= arenaRating - lower->first)
+            useLower = false;
+        else
+            useHigher = false;
+    }
+
+    if (useHigher)
+        result = higher->second;
+    else if (useLower)
+        result = lower->second;
+
+    return useHigher || useLower;
+}
+
+void BattleGroundQueue::RemoveFromRatedIndex(BattleGroundBracketId bracket_id, uint32 queue, GroupQueueInfo const* ginfo)
+{
+    RatedGroupsIndex& ratings = m_RatedGroups[bracket_id][queue];
+    std::pair<RatedGroupsIndex::iterator, RatedGroupsIndex::iterator> range = ratings.equal_range(ginfo->ArenaTeamRating);
+    for (RatedGroupsIndex::iterator itr = range.first; itr != range.second; ++itr)
+    {
+        if (*itr->second == ginfo)
+        {
+            ratings.erase(itr);
+            return;
+        }
+    }
+}
+
 /*********************************************************/
 /***            BATTLEGROUND QUEUE EVENTS              ***/
 /*********************************************************/
@@ -1183,13 +1233,14 @@ void BattleGroundMgr::Update(uint32 diff)
         // it's time to force update
         if (m_NextRatingDiscardUpdate < diff)
         {
-            // forced update for rated arenas (scan all, but skipped non rated)
+            // forced update for rated arenas (teams waiting longer than discard time), skipped brackets without possible match
             DEBUG_LOG("BattleGroundMgr: UPDATING ARENA QUEUES");
             for(int qtype = BATTLEGROUND_QUEUE_2v2; qtype <= BATTLEGROUND_QUEUE_5v5; ++qtype)
                 for(int bracket = BG_BRACKET_ID_FIRST; bracket < MAX_BATTLEGROUND_BRACKETS; ++bracket)
-                    m_BattleGroundQueues[qtype].Update(
-                        BATTLEGROUND_AA, BattleGroundBracketId(bracket),
-                        BattleGroundMgr::BGArenaType(BattleGroundQueueTypeId(qtype)), true, 0);
+                    if (m_BattleGroundQueues[qtype].HasRatedMatchCandidates(BattleGroundBracketId(bracket)))
+                        m_BattleGroundQueues[qtype].Update(
+                            BATTLEGROUND_AA, BattleGroundBracketId(bracket),
+                            BattleGroundMgr::BGArenaType(BattleGroundQueueTypeId(qtype)), true, 0);
 
             m_NextRatingDiscardUpdate = sWorld.getConfig(CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER);
         }
@@ -1751,11 +1802,18 @@ void BattleGroundMgr::DistributeArenaPoints()
         }
     }
 
+    // group players by points value, so database updated by few statements with guid lists instead statement per player
+    typedef std::map<uint32, std::vector<uint32> > PointsGroups;
+    PointsGroups pointsGroups;
+
     //cycle that gives points to all players
     for (std::map<uint32, uint32>::iterator plr_itr = PlayerPoints.begin(); plr_itr != PlayerPoints.end(); ++plr_itr)
     {
-        //update to database
-        CharacterDatabase.PExecute("UPDATE characters SET arenaPoints = arenaPoints + '%u' WHERE guid = '%u'", plr_itr->second, plr_itr->first);
+        if (!plr_itr->second)
+            continue;
+
+        pointsGroups[plr_itr->second].push_back(plr_itr->first);
+
         //add points if player is online
         if (Player* pl = sObjectMgr.GetPlayer(ObjectGuid(HIGHGUID_PLAYER, plr_itr->first)))
             pl->ModifyArenaPoints(plr_itr->second);
@@ -1763,6 +1821,16 @@ void BattleGroundMgr::DistributeArenaPoints()
 
     PlayerPoints.clear();
 
+    // all points and team stats changes saved in one transaction
+    CharacterDatabase.BeginTransaction();
+
+    for (PointsGroups::const_iterator grp_itr = pointsGroups.begin(); grp_itr != pointsGroups.end(); ++grp_itr)
+    {
+        std::ostringstream ss;
+        ss << "UPDATE characters SET arenaPoints = arenaPoints + '" << grp_itr->first << "' WHERE guid IN (";
+        CharacterDatabase.ExecuteIdList(ss.str().c_str(), grp_itr->second, ")", ARENA_POINTS_UPDATE_BATCH_SIZE);
+    }
+
     sWorld.SendWorldText(LANG_DIST_ARENA_POINTS_ONLINE_END);
 
     sWorld.SendWorldText(LANG_DIST_ARENA_POINTS_TEAM_START);
@@ -1771,11 +1839,13 @@ void BattleGroundMgr::DistributeArenaPoints()
         if (ArenaTeam * at = titr->second)
         {
             at->FinishWeek();                              // set played this week etc values to 0 in memory, too
-            at->SaveToDB();                                // save changes
+            at->SaveStatsToDB();                           // save changes
             at->NotifyStatsChanged();                      // notify the players of the changes
         }
     }
 
+    CharacterDatabase.CommitTransaction();
+
     sWorld.SendWorldText(LANG_DIST_ARENA_POINTS_TEAM_END);
 
     sWorld.SendWorldText(LANG_DIST_ARENA_POINTS_END);
@@ -88,6 +88,11 @@ class BattleGroundQueue
         bool GetPlayerGroupInfoData(const uint64& guid, GroupQueueInfo* ginfo);
         void PlayerInvitedToBGUpdateAverageWaitTime(GroupQueueInfo* ginfo, BattleGroundBracketId bracket_id);
         uint32 GetAverageQueueWaitTime(GroupQueueInfo* ginfo, BattleGroundBracketId bracket_id);
+        // at least 2 rated arena teams wait for match in bracket
+        bool HasRatedMatchCandidates(BattleGroundBracketId bracket_id) const
+        {
+            return m_RatedGroups[bracket_id][BG_TEAM_ALLIANCE].size() + m_RatedGroups[bracket_id][BG_TEAM_HORDE].size() >= 2;
+        }
 
     private:
         //mutex that should not allow changing private data, nor allowing to update Queue during private data change.
@@ -111,6 +116,15 @@ class BattleGroundQueue
         */
         GroupsQueueType m_QueuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
 
+        // not invited rated arena teams of premade queues (BG_QUEUE_PREMADE_ALLIANCE/HORDE) ordered by rating,
+        // teams with same rating in join order
+        typedef std::multimap<uint32, GroupsQueueType::iterator> RatedGroupsIndex;
+        RatedGroupsIndex m_RatedGroups[MAX_BATTLEGROUND_BRACKETS][BG_TEAMS_COUNT];
+
+        bool SelectRatedGroup(BattleGroundBracketId bracket_id, uint32 queue, uint32 arenaRating, uint32 minRating, uint32 maxRating,
+            uint32 discardTime, GroupQueueInfo const* exclude, GroupsQueueType::iterator& result);
+        void RemoveFromRatedIndex(BattleGroundBracketId bracket_id, uint32 queue, GroupQueueInfo const* ginfo);
+
         // class to select and invite groups to bg
         class SelectionPool
         {
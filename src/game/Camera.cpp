@@ -4,8 +4,10 @@
 #include "Log.h"
 #include "Errors.h"
 #include "Player.h"
+#include "World.h"
 
-Camera::Camera(Player* pl) : m_owner(*pl), m_source(pl)
+Camera::Camera(Player* pl) : m_owner(*pl), m_source(pl),
+    m_visibilityStamp(0), m_visibilityUpdateTimer(0), m_visibilityUpdateScheduled(false)
 {
     m_source->GetViewPoint().Attach(this);
 }
@@ -125,11 +127,40 @@ template void Camera::UpdateVisibilityOf(DynamicObject* , UpdateData& , std::set
 
 void Camera::UpdateVisibilityForOwner()
 {
+    m_visibilityUpdateScheduled = false;
+    m_visibilityUpdateTimer = sWorld.getConfig(CONFIG_UINT32_VISIBILITY_UPDATE_INTERVAL);
+
+    // 0 used for client guids added out of visibility update
+    if (++m_visibilityStamp == 0)
+        m_visibilityStamp = 1;
+
     MaNGOS::VisibleNotifier notifier(*this);
-    Cell::VisitAllObjects(m_source, notifier, m_source->GetMap()->GetVisibilityDistance(), false);
+    Cell::VisitAllObjects(m_source, notifier, m_source->GetMap()->GetVisibilityDistance(m_source), false);
     notifier.Notify();
 }
 
+void Camera::ScheduleVisibilityUpdate()
+{
+    if (m_visibilityUpdateTimer == 0)
+        UpdateVisibilityForOwner();
+    else
+        m_visibilityUpdateScheduled = true;
+}
+
+void Camera::UpdateVisibilityTimer(uint32 diff)
+{
+    if (m_visibilityUpdateTimer > diff)
+    {
+        m_visibilityUpdateTimer -= diff;
+        return;
+    }
+
+    m_visibilityUpdateTimer = 0;
+
+    if (m_visibilityUpdateScheduled)
+        UpdateVisibilityForOwner();
+}
+
 //////////////////
 
 ViewPoint::~ViewPoint()
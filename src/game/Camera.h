@@ -39,6 +39,13 @@ class MANGOS_DLL_SPEC Camera
         // updates visibility of worldobjects around viewpoint for camera's owner
         void UpdateVisibilityForOwner();
 
+        // request UpdateVisibilityForOwner call, done at next Map::Update if Visibility.UpdateInterval passed from last update
+        void ScheduleVisibilityUpdate();
+        void UpdateVisibilityTimer(uint32 diff);
+
+        // stamp for Player::m_clientGUIDs values set by current UpdateVisibilityForOwner
+        uint32 GetVisibilityStamp() const { return m_visibilityStamp; }
+
     private:
         // called when viewpoint changes visibility state
         void Event_AddedToWorld();
@@ -49,6 +56,10 @@ class MANGOS_DLL_SPEC Camera
         Player& m_owner;
         WorldObject* m_source;
 
+        uint32 m_visibilityStamp;
+        uint32 m_visibilityUpdateTimer;                     // time before next scheduled update can be done
+        bool m_visibilityUpdateScheduled;
+
         void UpdateForCurrentViewPoint();
 
     public:
@@ -116,6 +127,11 @@ public:
     {
         CameraCall(&Camera::UpdateVisibilityForOwner);
     }
+
+    void Call_ScheduleVisibilityUpdate()
+    {
+        CameraCall(&Camera::ScheduleVisibilityUpdate);
+    }
 };
 
 #endif
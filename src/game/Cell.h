@@ -23,10 +23,21 @@
 #include "GameSystem/TypeContainerVisitor.h"
 #include "GridDefines.h"
 #include <cmath>
+#include <vector>
 
 class Map;
 class WorldObject;
 
+namespace MaNGOS
+{
+    template<class Check> struct UnitListSearcher;
+
+    // 2d circle that contains all units accepted by unit check, used for query UnitSpatialIndex
+    // overloaded for range checks in GridNotifiers.h, checks without such area use grid cells search
+    template<class Check>
+    inline bool GetUnitCheckArea(Check const& /*check*/, float& /*x*/, float& /*y*/, float& /*radius*/) { return false; }
+}
+
 enum District
 {
     UPPER_DISTRICT = 1,
@@ -61,6 +72,15 @@ struct MANGOS_DLL_DECL CellArea
     int lower_offset;
 };
 
+// player visibility circle partly covering cell, see Map::ClassifyCellsInSight
+struct CellViewerRange
+{
+    float x, y;
+    float range;
+};
+
+typedef std::vector<CellViewerRange> CellViewerRangeList;
+
 struct MANGOS_DLL_DECL Cell
 {
     Cell() { data.All = 0; }
@@ -167,7 +187,11 @@ struct MANGOS_DLL_DECL Cell
     template<class T> static void VisitWorldObjects(const WorldObject *obj, T &visitor, float radius, bool dont_load = true);
     template<class T> static void VisitAllObjects(const WorldObject *obj, T &visitor, float radius, bool dont_load = true);
 
+    // unit list searcher use map unit spatial index (if enabled) with area of own check instead grid cells
+    template<class Check> static void VisitAllObjects(const WorldObject *obj, MaNGOS::UnitListSearcher<Check> &visitor, float radius, bool dont_load = true);
+
 private:
+    template<class T> static bool VisitUnitSpatialIndex(const WorldObject *obj, T &visitor, bool dont_load);
     template<class T, class CONTAINER> void VisitCircle(TypeContainerVisitor<T, CONTAINER> &, Map &, const CellPair& , const CellPair& ) const;
 };
 
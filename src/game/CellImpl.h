@@ -21,6 +21,7 @@
 
 #include "Cell.h"
 #include "Map.h"
+#include "UnitSpatialIndex.h"
 #include <cmath>
 
 inline Cell::Cell(CellPair const& p)
@@ -314,4 +315,36 @@ inline void Cell::VisitAllObjects(const WorldObject *center_obj, T &visitor, flo
     cell.Visit(p, wnotifier, *center_obj->GetMap(), *center_obj, radius);
 }
 
+template<class T>
+inline bool Cell::VisitUnitSpatialIndex(const WorldObject *center_obj, T &visitor, bool dont_load)
+{
+    // index contains only units in already loaded grids
+    if (!dont_load)
+        return false;
+
+    UnitSpatialIndex const* index = center_obj->GetMap()->GetUnitSpatialIndex();
+    if (!index)
+        return false;
+
+    // area from check itself, used only if it is inside standing cell, so grid cells visit would find same units
+    using MaNGOS::GetUnitCheckArea;
+    float x, y, area;
+    if (!GetUnitCheckArea(visitor.i_check, x, y, area) ||
+        !index->CanReplaceCellSearch(MaNGOS::ComputeCellPair(center_obj->GetPositionX(), center_obj->GetPositionY()), x, y, area))
+        return false;
+
+    index->VisitUnitsInRange(x, y, area, visitor);
+    return true;
+}
+
+template<class Check>
+inline void Cell::VisitAllObjects(const WorldObject *center_obj, MaNGOS::UnitListSearcher<Check> &visitor, float radius, bool dont_load)
+{
+    if (!VisitUnitSpatialIndex(center_obj, visitor, dont_load))
+    {
+        VisitGridObjects(center_obj, visitor, radius, dont_load);
+        VisitWorldObjects(center_obj, visitor, radius, dont_load);
+    }
+}
+
 #endif
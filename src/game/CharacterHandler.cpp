@@ -470,6 +470,8 @@ void WorldSession::HandleCharCreateOpcode( WorldPacket & recv_data )
     pNewChar->SaveToDB();
     charcount += 1;
 
+    sObjectMgr.AddCharacterNameData(pNewChar->GetObjectGuid(), pNewChar->GetName(), GetAccountId(), pNewChar->getRace(), pNewChar->getClass(), pNewChar->getGender(), pNewChar->getLevel());
+
     LoginDatabase.PExecute("DELETE FROM realmcharacters WHERE acctid= '%d' AND realmid = '%d'", GetAccountId(), realmID);
     LoginDatabase.PExecute("INSERT INTO realmcharacters (numchars, acctid, realmid) VALUES (%u, %u, %u)",  charcount, GetAccountId(), realmID);
 
@@ -948,9 +950,23 @@ void WorldSession::HandleChangePlayerNameOpcodeCallBack(QueryResult *result, uin
 
     delete result;
 
+    // name can be taken by character created or renamed after query
+    if (uint64 newguid = sObjectMgr.GetPlayerGUIDByName(newname))
+    {
+        if (newguid != guid.GetRawValue())
+        {
+            WorldPacket data(SMSG_CHAR_RENAME, 1);
+            data << uint8(CHAR_CREATE_NAME_IN_USE);
+            session->SendPacket( &data );
+            return;
+        }
+    }
+
     CharacterDatabase.PExecute("UPDATE characters set name = '%s', at_login = at_login & ~ %u WHERE guid ='%u'", newname.c_str(), uint32(AT_LOGIN_RENAME), guidLow);
     CharacterDatabase.PExecute("DELETE FROM character_declinedname WHERE guid ='%u'", guidLow);
 
+    sObjectMgr.UpdateCharacterName(guid, newname);
+
     sLog.outChar("Account: %d (IP: %s) Character:[%s] (guid:%u) Changed name to: %s", session->GetAccountId(), session->GetRemoteAddress().c_str(), oldname.c_str(), guidLow, newname.c_str());
 
     WorldPacket data(SMSG_CHAR_RENAME, 1+8+(newname.size()+1));
@@ -1032,6 +1048,8 @@ void WorldSession::HandleSetPlayerDeclinedNames(WorldPacket& recv_data)
         return;
     }
 
+    sObjectMgr.UpdateCharacterDeclinedNames(guid, declinedname);
+
     for(int i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
         CharacterDatabase.escape_string(declinedname.name[i]);
 
@@ -1185,6 +1203,9 @@ void WorldSession::HandleCharCustomize(WorldPacket& recv_data)
         }
     }
 
+    sObjectMgr.UpdateCharacterName(guid, newname);
+    sObjectMgr.UpdateCharacterGender(guid, gender);
+
     CharacterDatabase.escape_string(newname);
     Player::Customize(guid, gender, skin, face, hairStyle, hairColor, facialHair);
     CharacterDatabase.PExecute("UPDATE characters set name = '%s', at_login = at_login & ~ %u WHERE guid ='%u'", newname.c_str(), uint32(AT_LOGIN_CUSTOMIZE), GUID_LOPART(guid));
@@ -205,7 +205,10 @@ ChatCommand * ChatHandler::getCommandTable()
         { "getvalue",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugGetValueCommand,            "", NULL },
         { "moditemvalue",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugModItemValueCommand,        "", NULL },
         { "modvalue",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugModValueCommand,            "", NULL },
+        { "pathfinder",     SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugPathFinderCommand,          "", NULL },
         { "play",           SEC_MODERATOR,      false, NULL,                                                "", debugPlayCommandTable },
+        { "pools",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugPoolsCommand,               "", NULL },
+        { "querycache",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugQueryCacheCommand,          "", NULL },
         { "send",           SEC_ADMINISTRATOR,  false, NULL,                                                "", debugSendCommandTable },
         { "setaurastate",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugSetAuraStateCommand,        "", NULL },
         { "setitemvalue",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugSetItemValueCommand,        "", NULL },
@@ -214,6 +217,8 @@ ChatCommand * ChatHandler::getCommandTable()
         { "spellmods",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugSpellModsCommand,           "", NULL },
         { "spawnvehicle",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugSpawnVehicleCommand,        "", NULL },
         { "uws",            SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugUpdateWorldStateCommand,    "", NULL },
+        { "visibility",     SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugVisibilityCommand,          "", NULL },
+        { "visibilityzones",SEC_GAMEMASTER,     false, &ChatHandler::HandleDebugVisibilityZonesCommand,     "", NULL },
         { NULL,             0,                  false, NULL,                                                "", NULL }
     };
 
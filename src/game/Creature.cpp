@@ -120,10 +120,10 @@ Creature::Creature(CreatureSubtype subtype) :
 Unit(), i_AI(NULL),
 lootForPickPocketed(false), lootForBody(false), lootForSkin(false), m_groupLootTimer(0), m_groupLootId(0),
 m_lootMoney(0), m_lootGroupRecipientId(0),
-m_deathTimer(0), m_respawnTime(0), m_respawnDelay(25), m_corpseDelay(60), m_respawnradius(5.0f),
+m_deathTimer(0), m_respawnTime(0), m_respawnDelay(25), m_corpseDelay(60), m_dormantTime(0), m_respawnradius(5.0f),
 m_subtype(subtype), m_defaultMovementType(IDLE_MOTION_TYPE), m_DBTableGuid(0), m_equipmentId(0),
 m_AlreadyCallAssistance(false), m_AlreadySearchedAssistance(false),
-m_regenHealth(true), m_AI_locked(false), m_isDeadByDefault(false), m_needNotify(false),
+m_regenHealth(true), m_AI_locked(false), m_isDeadByDefault(false),
 m_meleeDamageSchoolMask(SPELL_SCHOOL_MASK_NORMAL),
 m_creatureInfo(NULL), m_splineFlags(SPLINEFLAG_WALKMODE)
 {
@@ -157,6 +157,10 @@ void Creature::AddToWorld()
         GetMap()->GetObjectsStore().insert<Creature>(GetGUID(), (Creature*)this);
 
     Unit::AddToWorld();
+
+    // loaded dead: respawn time not passed yet or dead by default
+    if (m_deathState == DEAD)
+        GetMap()->ScheduleRespawn(this, m_respawnTime);
 }
 
 void Creature::RemoveFromWorld()
@@ -190,6 +194,8 @@ void Creature::RemoveCorpse()
     float x, y, z, o;
     GetRespawnCoord(x, y, z, &o);
     GetMap()->CreatureRelocation(this, x, y, z, o);
+
+    GetMap()->ScheduleRespawn(this, m_respawnTime);
 }
 
 /**
@@ -405,20 +411,17 @@ uint32 Creature::ChooseDisplayId(const CreatureInfo *cinfo, const CreatureData *
 
 void Creature::Update(uint32 diff)
 {
+    if (m_dormantTime)
+    {
+        CatchUpDormantTime(m_dormantTime);
+        m_dormantTime = 0;
+    }
+
     if(m_GlobalCooldown <= diff)
         m_GlobalCooldown = 0;
     else
         m_GlobalCooldown -= diff;
 
-    if (m_needNotify)
-    {
-        m_needNotify = false;
-        RelocationNotify();
-
-        if (!IsInWorld())
-            return;
-    }
-
     switch( m_deathState )
     {
         case JUST_ALIVED:
@@ -429,41 +432,8 @@ void Creature::Update(uint32 diff)
             // Don't must be called, see Creature::setDeathState JUST_DIED -> CORPSE promoting.
             sLog.outError("Creature (GUIDLow: %u Entry: %u ) in wrong state: JUST_DEAD (1)",GetGUIDLow(),GetEntry());
             break;
-        case DEAD:
-        {
-            if( m_respawnTime <= time(NULL) )
-            {
-                DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "Respawning...");
-                m_respawnTime = 0;
-                lootForPickPocketed = false;
-                lootForBody         = false;
-                lootForSkin         = false;
-
-                if(m_originalEntry != GetEntry())
-                    UpdateEntry(m_originalEntry);
-
-                CreatureInfo const *cinfo = GetCreatureInfo();
-
-                SelectLevel(cinfo);
-                SetUInt32Value(UNIT_DYNAMIC_FLAGS, 0);
-                if (m_isDeadByDefault)
-                {
-                    setDeathState(JUST_DIED);
-                    SetHealth(0);
-                    i_motionMaster.Clear();
-                    clearUnitState(UNIT_STAT_ALL_STATE);
-                    LoadCreaturesAddon(true);
-                }
-                else
-                    setDeathState( JUST_ALIVED );
-
-                //Call AI respawn virtual function
-                i_AI->JustRespawned();
-
-                GetMap()->Add(this);
-            }
+        case DEAD:                                          // respawn at time from Map respawn queue, see UpdateRespawn
             break;
-        }
         case CORPSE:
         {
             if (m_isDeadByDefault)
@@ -1456,9 +1426,62 @@ void Creature::Respawn()
         if (m_DBTableGuid)
             sObjectMgr.SaveCreatureRespawnTime(m_DBTableGuid,GetInstanceId(), 0);
         m_respawnTime = time(NULL);                         // respawn at next tick
+        GetMap()->ScheduleRespawn(this, m_respawnTime);
     }
 }
 
+void Creature::SetRespawnTime(uint32 respawn)
+{
+    m_respawnTime = respawn ? time(NULL) + respawn : 0;
+
+    // respawn can be moved to earlier time than already scheduled
+    if (m_deathState == DEAD && IsInWorld())
+        GetMap()->ScheduleRespawn(this, m_respawnTime);
+}
+
+void Creature::UpdateRespawn(time_t now)
+{
+    // already respawned or queue entry outdated by new death
+    if (m_deathState != DEAD)
+        return;
+
+    // respawn time moved to later time after scheduling
+    if (m_respawnTime > now)
+    {
+        GetMap()->ScheduleRespawn(this, m_respawnTime);
+        return;
+    }
+
+    DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "Respawning...");
+    m_respawnTime = 0;
+    lootForPickPocketed = false;
+    lootForBody         = false;
+    lootForSkin         = false;
+
+    if(m_originalEntry != GetEntry())
+        UpdateEntry(m_originalEntry);
+
+    CreatureInfo const *cinfo = GetCreatureInfo();
+
+    SelectLevel(cinfo);
+    SetUInt32Value(UNIT_DYNAMIC_FLAGS, 0);
+    if (m_isDeadByDefault)
+    {
+        setDeathState(JUST_DIED);
+        SetHealth(0);
+        i_motionMaster.Clear();
+        clearUnitState(UNIT_STAT_ALL_STATE);
+        LoadCreaturesAddon(true);
+    }
+    else
+        setDeathState( JUST_ALIVED );
+
+    //Call AI respawn virtual function
+    i_AI->JustRespawned();
+
+    GetMap()->Add(this);
+}
+
 void Creature::ForcedDespawn(uint32 timeMSToDespawn)
 {
     if (timeMSToDespawn)
@@ -2240,6 +2263,73 @@ void Creature::SetActiveObjectState( bool on )
         map->Add(this);
 }
 
+CreatureActivity Creature::GetActivity() const
+{
+    if (isInCombat() || IsInEvadeMode())
+        return CREATURE_ACTIVITY_COMBAT;
+
+    switch (m_deathState)
+    {
+        case ALIVE:
+            // corpse removal and group loot rolls seen by players in visibility range
+            if (m_isDeadByDefault && m_deathTimer <= m_dormantTime)
+                return CREATURE_ACTIVITY_ACTIVE;
+            break;
+        case CORPSE:
+            if (m_deathTimer <= m_dormantTime || m_groupLootId)
+                return CREATURE_ACTIVITY_ACTIVE;
+            break;
+        case DEAD:                                          // respawned by Map respawn queue without Update
+            break;
+        default:                                            // death state switches processed in Update
+            return CREATURE_ACTIVITY_ACTIVE;
+    }
+
+    // pets, totems, summons and other subtypes have own timers in Update
+    if (m_subtype != CREATURE_SUBTYPE_GENERIC || isActiveObject() || GetCharmerOrOwnerGUID())
+        return CREATURE_ACTIVITY_ACTIVE;
+
+    // script library AI can expect updates out of combat (events, escorts)
+    if (GetScriptId() || !m_Events.Empty() || IsNonMeleeSpellCasted(false))
+        return CREATURE_ACTIVITY_ACTIVE;
+
+    // patrols and random movement must continue in sync with client side movement
+    if (hasUnitState(UNIT_STAT_MOVING) || i_motionMaster.GetCurrentMovementGeneratorType() != IDLE_MOTION_TYPE)
+        return CREATURE_ACTIVITY_ACTIVE;
+
+    return CREATURE_ACTIVITY_IDLE;
+}
+
+// AI, movement and auras just continue from skipped state (like for creatures in grids without players),
+// only timers with effect visible at wakeup caught up
+void Creature::CatchUpDormantTime(uint32 diff)
+{
+    m_GlobalCooldown = m_GlobalCooldown > diff ? m_GlobalCooldown - diff : 0;
+
+    switch (m_deathState)
+    {
+        case CORPSE:
+            // expired corpse removed in current Update
+            m_deathTimer = m_deathTimer > diff ? m_deathTimer - diff : 0;
+            break;
+        case ALIVE:
+        {
+            if (m_isDeadByDefault)
+                m_deathTimer = m_deathTimer > diff ? m_deathTimer - diff : 0;
+
+            // out of combat regeneration restore 1/3 of max value per REGEN_TIME_FULL, so 3 ticks enough for any time
+            for (uint32 ticks = std::min(diff / REGEN_TIME_FULL, uint32(3)); ticks > 0; --ticks)
+            {
+                RegenerateHealth();
+                RegenerateMana();
+            }
+            break;
+        }
+        default:                                            // respawn time is absolute, nothing to catch up
+            break;
+    }
+}
+
 void Creature::SendMonsterMoveWithSpeedToCurrentDestination(Player* player)
 {
     float x, y, z;
@@ -2257,9 +2347,9 @@ void Creature::SendAreaSpiritHealerQueryOpcode(Player *pl)
     pl->SendDirectMessage(&data);
 }
 
-void Creature::RelocationNotify()
+void Creature::RelocationNotify(uint32 notifyPass)
 {
-    MaNGOS::CreatureRelocationNotifier relocationNotifier(*this);
+    MaNGOS::CreatureRelocationNotifier relocationNotifier(*this, notifyPass);
     float radius = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
     Cell::VisitAllObjects(this, relocationNotifier, radius);
 }
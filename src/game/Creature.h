@@ -381,6 +381,14 @@ enum CreatureSubtype
     CREATURE_SUBTYPE_TEMPORARY_SUMMON,                      // new TemporarySummon
 };
 
+// Creature update need in Map::Update, see Creature::GetActivity
+enum CreatureActivity
+{
+    CREATURE_ACTIVITY_COMBAT,                               // in combat or evading, always updated
+    CREATURE_ACTIVITY_ACTIVE,                               // active object, controlled, scripted, moving or casting, always updated
+    CREATURE_ACTIVITY_IDLE,                                 // stationary without own timers, update skipped out of sight of all players (see CreatureDormantOutOfSight)
+};
+
 class MANGOS_DLL_SPEC Creature : public Unit
 {
     CreatureAI *i_AI;
@@ -591,8 +599,10 @@ class MANGOS_DLL_SPEC Creature : public Unit
 
         time_t const& GetRespawnTime() const { return m_respawnTime; }
         time_t GetRespawnTimeEx() const;
-        void SetRespawnTime(uint32 respawn) { m_respawnTime = respawn ? time(NULL) + respawn : 0; }
+        void SetRespawnTime(uint32 respawn);
         void Respawn();
+        // called from Map respawn queue at scheduled time, respawn dead creature if respawn time passed
+        void UpdateRespawn(time_t now);
         void SaveRespawnTime();
 
         uint32 GetRespawnDelay() const { return m_respawnDelay; }
@@ -635,14 +645,18 @@ class MANGOS_DLL_SPEC Creature : public Unit
 
         void SetActiveObjectState(bool on);
 
-        void SetNeedNotify() { m_needNotify = true; }
+        CreatureActivity GetActivity() const;
+        // skipped update time, applied by CatchUpDormantTime at next Update call
+        void AddDormantTime(uint32 diff) { m_dormantTime += diff; }
+
+        // called from Map::ProcessRelocationNotifies, use Map::ScheduleRelocationNotify for request notify
+        void RelocationNotify(uint32 notifyPass = 0);
 
         void SendAreaSpiritHealerQueryOpcode(Player *pl);
 
     protected:
         bool CreateFromProto(uint32 guidlow,uint32 Entry,uint32 team, const CreatureData *data = NULL);
         bool InitEntry(uint32 entry, uint32 team=ALLIANCE, const CreatureData* data=NULL);
-        void RelocationNotify();
 
         uint32 m_groupLootTimer;                            // (msecs)timer used for group loot
         uint32 m_groupLootId;                               // used to find group which is looting corpse
@@ -665,11 +679,13 @@ class MANGOS_DLL_SPEC Creature : public Unit
         time_t m_respawnTime;                               // (secs) time of next respawn
         uint32 m_respawnDelay;                              // (secs) delay between corpse disappearance and respawning
         uint32 m_corpseDelay;                               // (secs) delay between death and corpse disappearance
+        uint32 m_dormantTime;                               // (msecs) update time skipped while dormant
         float m_respawnradius;
 
         CreatureSubtype m_subtype;                          // set in Creatures subclasses for fast it detect without dynamic_cast use
         void RegenerateMana();
         void RegenerateHealth();
+        void CatchUpDormantTime(uint32 diff);
         MovementGeneratorType m_defaultMovementType;
         Cell m_currentCell;                                 // store current cell where creature listed
         uint32 m_DBTableGuid;                               ///< For new or temporary creatures is 0 for saved it is lowguid
@@ -680,7 +696,6 @@ class MANGOS_DLL_SPEC Creature : public Unit
         bool m_regenHealth;
         bool m_AI_locked;
         bool m_isDeadByDefault;
-        bool m_needNotify;
 
         SpellSchoolMask m_meleeDamageSchoolMask;
         uint32 m_originalEntry;
@@ -107,6 +107,7 @@ CreatureEventAI::CreatureEventAI(Creature *c ) : CreatureAI(c)
         sLog.outError("CreatureEventAI: EventMap for Creature %u is empty but creature is using CreatureEventAI.", m_creature->GetEntry());
 
     m_bEmptyList = m_CreatureEventAIList.empty();
+    m_TimersRunning = false;
     m_Phase = 0;
     m_CombatMovementEnabled = true;
     m_MeleeEnabled = true;
@@ -115,16 +116,59 @@ CreatureEventAI::CreatureEventAI(Creature *c ) : CreatureAI(c)
 
     m_InvinceabilityHpLevel = 0;
 
+    BuildEventIndex();
+
     //Handle Spawned Events
     if (!m_bEmptyList)
     {
-        for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-            if (SpawnedEventConditionsCheck((*i).Event))
-                ProcessEvent(*i);
+        for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_SPAWNED); i != EventsEnd(EVENT_T_SPAWNED); ++i)
+            if (SpawnedEventConditionsCheck((*i)->Event))
+                ProcessEvent(**i);
     }
     Reset();
 }
 
+void CreatureEventAI::BuildEventIndex()
+{
+    // counting sort by event type, list order kept in type group
+    for (int type = 0; type <= EVENT_T_END; ++type)
+        m_EventsByTypeStart[type] = 0;
+
+    for (CreatureEventAIList::const_iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+        ++m_EventsByTypeStart[(*i).Event.event_type + 1];
+
+    for (int type = 0; type < EVENT_T_END; ++type)
+        m_EventsByTypeStart[type + 1] += m_EventsByTypeStart[type];
+
+    uint16 next[EVENT_T_END];
+    for (int type = 0; type < EVENT_T_END; ++type)
+        next[type] = m_EventsByTypeStart[type];
+
+    m_EventsByType.resize(m_CreatureEventAIList.size());
+    m_PeriodicEvents.clear();
+
+    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    {
+        m_EventsByType[next[(*i).Event.event_type]++] = &*i;
+
+        switch ((*i).Event.event_type)
+        {
+            case EVENT_T_TIMER_OOC:
+            case EVENT_T_TIMER:
+            case EVENT_T_MANA:
+            case EVENT_T_HP:
+            case EVENT_T_TARGET_HP:
+            case EVENT_T_TARGET_CASTING:
+            case EVENT_T_FRIENDLY_HP:
+            case EVENT_T_RANGE:
+                m_PeriodicEvents.push_back(&*i);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& pHolder, Unit* pActionInvoker)
 {
     if (!pHolder.Enabled || pHolder.Time)
@@ -339,6 +383,10 @@ bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& pHolder, Unit* pAction
             break;
     }
 
+    //Repeat timer started, need timer updates
+    if (pHolder.Time)
+        m_TimersRunning = true;
+
     //Disable non-repeatable events
     if (!(pHolder.Event.event_flags & EFLAG_REPEATABLE))
         pHolder.Enabled = false;
@@ -549,9 +597,10 @@ void CreatureEventAI::ProcessAction(CreatureEventAI_Action const& action, uint32
             break;
         case ACTION_T_THREAT_ALL_PCT:
         {
+            // threat to pet owner can be added in loop, so index access instead iterator
             ThreatList const& threatList = m_creature->getThreatManager().getThreatList();
-            for (ThreatList::const_iterator i = threatList.begin(); i != threatList.end(); ++i)
-                if(Unit* Temp = m_creature->GetMap()->GetUnit((*i)->getUnitGuid()))
+            for (size_t i = 0; i < threatList.size(); ++i)
+                if(Unit* Temp = m_creature->GetMap()->GetUnit(threatList[i]->getUnitGuid()))
                     m_creature->getThreatManager().modifyThreatPercent(Temp, action.threat_all_pct.percent);
             break;
         }
@@ -836,9 +885,9 @@ void CreatureEventAI::JustRespawned()
         return;
 
     //Handle Spawned Events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-        if (SpawnedEventConditionsCheck((*i).Event))
-            ProcessEvent(*i);
+    for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_SPAWNED); i != EventsEnd(EVENT_T_SPAWNED); ++i)
+        if (SpawnedEventConditionsCheck((*i)->Event))
+            ProcessEvent(**i);
 }
 
 void CreatureEventAI::Reset()
@@ -860,6 +909,8 @@ void CreatureEventAI::Reset()
             {
                 if ((*i).UpdateRepeatTimer(m_creature,event.timer.initialMin,event.timer.initialMax))
                     (*i).Enabled = true;
+                if ((*i).Time)
+                    m_TimersRunning = true;
                 break;
             }
             //default:
@@ -875,11 +926,8 @@ void CreatureEventAI::JustReachedHome()
 {
     if (!m_bEmptyList)
     {
-        for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-        {
-            if ((*i).Event.event_type == EVENT_T_REACHED_HOME)
-                ProcessEvent(*i);
-        }
+        for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_REACHED_HOME); i != EventsEnd(EVENT_T_REACHED_HOME); ++i)
+            ProcessEvent(**i);
     }
 
     Reset();
@@ -900,11 +948,8 @@ void CreatureEventAI::EnterEvadeMode()
         return;
 
     //Handle Evade events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if ((*i).Event.event_type == EVENT_T_EVADE)
-            ProcessEvent(*i);
-    }
+    for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_EVADE); i != EventsEnd(EVENT_T_EVADE); ++i)
+        ProcessEvent(**i);
 }
 
 void CreatureEventAI::JustDied(Unit* killer)
@@ -921,12 +966,9 @@ void CreatureEventAI::JustDied(Unit* killer)
     if (m_bEmptyList)
         return;
 
-    //Handle Evade events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if ((*i).Event.event_type == EVENT_T_DEATH)
-            ProcessEvent(*i, killer);
-    }
+    //Handle Death events
+    for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_DEATH); i != EventsEnd(EVENT_T_DEATH); ++i)
+        ProcessEvent(**i, killer);
 
     // reset phase after any death state events
     m_Phase = 0;
@@ -937,11 +979,8 @@ void CreatureEventAI::KilledUnit(Unit* victim)
     if (m_bEmptyList || victim->GetTypeId() != TYPEID_PLAYER)
         return;
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if ((*i).Event.event_type == EVENT_T_KILL)
-            ProcessEvent(*i, victim);
-    }
+    for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_KILL); i != EventsEnd(EVENT_T_KILL); ++i)
+        ProcessEvent(**i, victim);
 }
 
 void CreatureEventAI::JustSummoned(Creature* pUnit)
@@ -949,11 +988,8 @@ void CreatureEventAI::JustSummoned(Creature* pUnit)
     if (m_bEmptyList || !pUnit)
         return;
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if ((*i).Event.event_type == EVENT_T_SUMMONED_UNIT)
-            ProcessEvent(*i, pUnit);
-    }
+    for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_SUMMONED_UNIT); i != EventsEnd(EVENT_T_SUMMONED_UNIT); ++i)
+        ProcessEvent(**i, pUnit);
 }
 
 void CreatureEventAI::SummonedCreatureJustDied(Creature* pUnit)
@@ -961,11 +997,8 @@ void CreatureEventAI::SummonedCreatureJustDied(Creature* pUnit)
     if (m_bEmptyList || !pUnit)
         return;
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if ((*i).Event.event_type == EVENT_T_SUMMONED_JUST_DIED)
-            ProcessEvent(*i, pUnit);
-    }
+    for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_SUMMONED_JUST_DIED); i != EventsEnd(EVENT_T_SUMMONED_JUST_DIED); ++i)
+        ProcessEvent(**i, pUnit);
 }
 
 void CreatureEventAI::SummonedCreatureDespawn(Creature* pUnit)
@@ -973,11 +1006,8 @@ void CreatureEventAI::SummonedCreatureDespawn(Creature* pUnit)
     if (m_bEmptyList || !pUnit)
         return;
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if ((*i).Event.event_type == EVENT_T_SUMMONED_JUST_DESPAWN)
-            ProcessEvent(*i, pUnit);
-    }
+    for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_SUMMONED_JUST_DESPAWN); i != EventsEnd(EVENT_T_SUMMONED_JUST_DESPAWN); ++i)
+        ProcessEvent(**i, pUnit);
 }
 
 void CreatureEventAI::EnterCombat(Unit *enemy)
@@ -998,6 +1028,9 @@ void CreatureEventAI::EnterCombat(Unit *enemy)
                 case EVENT_T_TIMER:
                     if ((*i).UpdateRepeatTimer(m_creature,event.timer.initialMin,event.timer.initialMax))
                         (*i).Enabled = true;
+
+                    if ((*i).Time)
+                        m_TimersRunning = true;
                     break;
                     //All normal events need to be re-enabled and their time set to 0
                 default:
@@ -1043,21 +1076,18 @@ void CreatureEventAI::MoveInLineOfSight(Unit *who)
     //Check for OOC LOS Event
     if (!m_bEmptyList && !m_creature->getVictim())
     {
-        for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+        for (CreatureEventAIHolderList::const_iterator itr = EventsBegin(EVENT_T_OOC_LOS); itr != EventsEnd(EVENT_T_OOC_LOS); ++itr)
         {
-            if ((*itr).Event.event_type == EVENT_T_OOC_LOS)
-            {
-                //can trigger if closer than fMaxAllowedRange
-                float fMaxAllowedRange = (float)(*itr).Event.ooc_los.maxRange;
+            //can trigger if closer than fMaxAllowedRange
+            float fMaxAllowedRange = (float)(*itr)->Event.ooc_los.maxRange;
 
-                //if range is ok and we are actually in LOS
-                if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
-                {
-                    //if friendly event&&who is not hostile OR hostile event&&who is hostile
-                    if (((*itr).Event.ooc_los.noHostile && !m_creature->IsHostileTo(who)) ||
-                        ((!(*itr).Event.ooc_los.noHostile) && m_creature->IsHostileTo(who)))
-                        ProcessEvent(*itr, who);
-                }
+            //if range is ok and we are actually in LOS
+            if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
+            {
+                //if friendly event&&who is not hostile OR hostile event&&who is hostile
+                if (((*itr)->Event.ooc_los.noHostile && !m_creature->IsHostileTo(who)) ||
+                    ((!(*itr)->Event.ooc_los.noHostile) && m_creature->IsHostileTo(who)))
+                    ProcessEvent(**itr, who);
             }
         }
     }
@@ -1094,12 +1124,11 @@ void CreatureEventAI::SpellHit(Unit* pUnit, const SpellEntry* pSpell)
     if (m_bEmptyList)
         return;
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-        if ((*i).Event.event_type == EVENT_T_SPELLHIT)
-            //If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (!(*i).Event.spell_hit.spellId || pSpell->Id == (*i).Event.spell_hit.spellId)
-                if (pSpell->SchoolMask & (*i).Event.spell_hit.schoolMask)
-                    ProcessEvent(*i, pUnit);
+    for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_SPELLHIT); i != EventsEnd(EVENT_T_SPELLHIT); ++i)
+        //If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (!(*i)->Event.spell_hit.spellId || pSpell->Id == (*i)->Event.spell_hit.spellId)
+            if (pSpell->SchoolMask & (*i)->Event.spell_hit.schoolMask)
+                ProcessEvent(**i, pUnit);
 }
 
 void CreatureEventAI::UpdateAI(const uint32 diff)
@@ -1118,49 +1147,39 @@ void CreatureEventAI::UpdateAI(const uint32 diff)
         {
             m_EventDiff += diff;
 
-            //Check for time based events
-            for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+            if (m_TimersRunning)
             {
-                //Decrement Timers
-                if ((*i).Time)
+                m_TimersRunning = false;                    // set again by not expired timer or started repeat timer
+
+                //Check for time based events
+                for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
                 {
-                    if ((*i).Time > m_EventDiff)
+                    //Decrement Timers
+                    if ((*i).Time)
                     {
-                        //Do not decrement timers if event cannot trigger in this phase
-                        if (!((*i).Event.event_inverse_phase_mask & (1 << m_Phase)))
-                            (*i).Time -= m_EventDiff;
+                        if ((*i).Time > m_EventDiff)
+                        {
+                            //Do not decrement timers if event cannot trigger in this phase
+                            if (!((*i).Event.event_inverse_phase_mask & (1 << m_Phase)))
+                                (*i).Time -= m_EventDiff;
 
-                        //Skip processing of events that have time remaining
-                        continue;
-                    }
-                    else (*i).Time = 0;
-                }
+                            m_TimersRunning = true;
 
-                //Events that are updated every EVENT_UPDATE_TIME
-                switch ((*i).Event.event_type)
-                {
-                    case EVENT_T_TIMER_OOC:
-                        ProcessEvent(*i);
-                        break;
-                    case EVENT_T_TIMER:
-                    case EVENT_T_MANA:
-                    case EVENT_T_HP:
-                    case EVENT_T_TARGET_HP:
-                    case EVENT_T_TARGET_CASTING:
-                    case EVENT_T_FRIENDLY_HP:
-                        if (Combat)
-                            ProcessEvent(*i);
-                        break;
-                    case EVENT_T_RANGE:
-                        if (Combat)
-                        {
-                            if (m_creature->getVictim() && m_creature->IsInMap(m_creature->getVictim()))
-                                if (m_creature->IsInRange(m_creature->getVictim(), (float)(*i).Event.range.minDist, (float)(*i).Event.range.maxDist))
-                                    ProcessEvent(*i);
+                            //Skip processing of events that have time remaining
+                            continue;
                         }
-                        break;
+                        else (*i).Time = 0;
+                    }
+
+                    UpdatePeriodicEvent(*i, Combat);
                 }
             }
+            // all timers expired, only periodic events can be processed, and out of combat only OOC timers
+            else if (Combat || EventsBegin(EVENT_T_TIMER_OOC) != EventsEnd(EVENT_T_TIMER_OOC))
+            {
+                for (CreatureEventAIHolderList::const_iterator i = m_PeriodicEvents.begin(); i != m_PeriodicEvents.end(); ++i)
+                    UpdatePeriodicEvent(**i, Combat);
+            }
 
             m_EventDiff = 0;
             m_EventUpdateTime = EVENT_UPDATE_TIME;
@@ -1177,6 +1196,36 @@ void CreatureEventAI::UpdateAI(const uint32 diff)
         DoMeleeAttackIfReady();
 }
 
+void CreatureEventAI::UpdatePeriodicEvent(CreatureEventAIHolder& pHolder, bool Combat)
+{
+    //Events that are updated every EVENT_UPDATE_TIME
+    switch (pHolder.Event.event_type)
+    {
+        case EVENT_T_TIMER_OOC:
+            ProcessEvent(pHolder);
+            break;
+        case EVENT_T_TIMER:
+        case EVENT_T_MANA:
+        case EVENT_T_HP:
+        case EVENT_T_TARGET_HP:
+        case EVENT_T_TARGET_CASTING:
+        case EVENT_T_FRIENDLY_HP:
+            if (Combat)
+                ProcessEvent(pHolder);
+            break;
+        case EVENT_T_RANGE:
+            if (Combat)
+            {
+                if (m_creature->getVictim() && m_creature->IsInMap(m_creature->getVictim()))
+                    if (m_creature->IsInRange(m_creature->getVictim(), (float)pHolder.Event.range.minDist, (float)pHolder.Event.range.maxDist))
+                        ProcessEvent(pHolder);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
 bool CreatureEventAI::IsVisible(Unit *pl) const
 {
     return m_creature->IsWithinDist(pl,sWorld.getConfig(CONFIG_FLOAT_SIGHT_MONSTER))
@@ -1383,19 +1432,16 @@ void CreatureEventAI::ReceiveEmote(Player* pPlayer, uint32 text_emote)
     if (m_bEmptyList)
         return;
 
-    for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+    for (CreatureEventAIHolderList::const_iterator itr = EventsBegin(EVENT_T_RECEIVE_EMOTE); itr != EventsEnd(EVENT_T_RECEIVE_EMOTE); ++itr)
     {
-        if ((*itr).Event.event_type == EVENT_T_RECEIVE_EMOTE)
-        {
-            if ((*itr).Event.receive_emote.emoteId != text_emote)
-                return;
+        if ((*itr)->Event.receive_emote.emoteId != text_emote)
+            return;
 
-            PlayerCondition pcon((*itr).Event.receive_emote.condition,(*itr).Event.receive_emote.conditionValue1,(*itr).Event.receive_emote.conditionValue2);
-            if (pcon.Meets(pPlayer))
-            {
-                DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "CreatureEventAI: ReceiveEmote CreatureEventAI: Condition ok, processing");
-                ProcessEvent(*itr, pPlayer);
-            }
+        PlayerCondition pcon((*itr)->Event.receive_emote.condition,(*itr)->Event.receive_emote.conditionValue1,(*itr)->Event.receive_emote.conditionValue2);
+        if (pcon.Meets(pPlayer))
+        {
+            DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "CreatureEventAI: ReceiveEmote CreatureEventAI: Condition ok, processing");
+            ProcessEvent(**itr, pPlayer);
         }
     }
 }
@@ -615,14 +615,29 @@ class MANGOS_DLL_SPEC CreatureEventAI : public CreatureAI
         void DoFindFriendlyCC(std::list<Creature*>& _list, float range);
 
     protected:
+        typedef std::vector<CreatureEventAIHolder*> CreatureEventAIHolderList;
+
+        void BuildEventIndex();
+        void UpdatePeriodicEvent(CreatureEventAIHolder& pHolder, bool Combat);
+
+        // events of selected type, in m_CreatureEventAIList order
+        CreatureEventAIHolderList::const_iterator EventsBegin(EventAI_Type type) const { return m_EventsByType.begin() + m_EventsByTypeStart[type]; }
+        CreatureEventAIHolderList::const_iterator EventsEnd(EventAI_Type type) const { return m_EventsByType.begin() + m_EventsByTypeStart[type + 1]; }
+
         uint32 m_EventUpdateTime;                           //Time between event updates
         uint32 m_EventDiff;                                 //Time between the last event call
         bool   m_bEmptyList;
+        bool   m_TimersRunning;                             // some event has not expired Time, all events must be checked at periodic update
 
         //Variables used by Events themselves
         typedef std::vector<CreatureEventAIHolder> CreatureEventAIList;
         CreatureEventAIList m_CreatureEventAIList;          //Holder for events (stores enabled, time, and eventid)
 
+        // index into m_CreatureEventAIList, not changed after constructor
+        CreatureEventAIHolderList m_EventsByType;           // grouped by event type
+        uint16 m_EventsByTypeStart[EVENT_T_END + 1];        // type group start in m_EventsByType
+        CreatureEventAIHolderList m_PeriodicEvents;         // events checked at periodic update (timers and combat conditions)
+
         uint8  m_Phase;                                     // Current phase, max 32 phases
         bool   m_CombatMovementEnabled;                     // If we allow targeted movment gen (movement twoards top threat)
         bool   m_MeleeEnabled;                              // If we allow melee auto attack
@@ -21,6 +21,7 @@
 
 #include "Platform/Define.h"
 #include "Timer.h"
+#include "Path.h"
 
 class WorldObject;
 class Map;
@@ -35,21 +36,29 @@ class MANGOS_DLL_DECL DestinationHolder
     uint32 i_timeElapsed;
     bool i_destSet;
     float i_fromX, i_fromY, i_fromZ;
-    float i_destX, i_destY, i_destZ;
+    float i_destX, i_destY, i_destZ;                        // current path segment end
+    float i_finalX, i_finalY, i_finalZ;                     // final destination point
+    SimplePath i_path;                                      // path points if pathfinder used for travel
+    uint32 i_pathIndex;
+    bool i_pathBuilt;                                       // pathfinder used for current destination (path can be direct)
 
     public:
         DestinationHolder() : i_tracker(TRAVELLER_UPDATE_INTERVAL), i_totalTravelTime(0), i_timeElapsed(0),
-            i_destSet(false), i_fromX(0), i_fromY(0), i_fromZ(0), i_destX(0), i_destY(0), i_destZ(0) {}
+            i_destSet(false), i_fromX(0), i_fromY(0), i_fromZ(0), i_destX(0), i_destY(0), i_destZ(0),
+            i_finalX(0), i_finalY(0), i_finalZ(0), i_pathIndex(0), i_pathBuilt(false) {}
 
-        uint32 SetDestination(TRAVELLER &traveller, float dest_x, float dest_y, float dest_z, bool sendMove = true);
-        void GetDestination(float &x, float &y, float &z) const { x = i_destX; y = i_destY; z = i_destZ; }
+        // with usePath return total travel time for all path segments,
+        // path not rebuilt if new destination in same pathfinder node as old (only path end point moved)
+        uint32 SetDestination(TRAVELLER &traveller, float dest_x, float dest_y, float dest_z, bool sendMove = true, bool usePath = false);
+        void GetDestination(float &x, float &y, float &z) const { x = i_finalX; y = i_finalY; z = i_finalZ; }
         bool UpdateExpired(void) const { return i_tracker.Passed(); }
         void ResetUpdate(uint32 t = TRAVELLER_UPDATE_INTERVAL) { i_tracker.Reset(t); }
         uint32 GetTotalTravelTime(void) const { return i_totalTravelTime; }
         void IncreaseTravelTime(uint32 increment) { i_totalTravelTime += increment; }
         bool HasDestination(void) const { return i_destSet; }
         float GetDestinationDiff(float x, float y, float z) const;
-        bool HasArrived(void) const { return (i_totalTravelTime == 0 || i_timeElapsed >= i_totalTravelTime); }
+        // arrived to final destination, all path segments passed
+        bool HasArrived(void) const { return i_pathIndex + 1 >= i_path.size() && _segmentArrived(); }
         bool UpdateTraveller(TRAVELLER &traveller, uint32 diff, bool force_update=false, bool micro_movement=false);
         uint32 StartTravel(TRAVELLER &traveller, bool sendMove = true);
         void GetLocationNow(const Map * map, float &x, float &y, float &z, bool is3D = false) const;
@@ -57,6 +66,9 @@ class MANGOS_DLL_DECL DestinationHolder
         float GetDistance3dFromDestSq(const WorldObject &obj) const;
 
     private:
+        bool _segmentArrived(void) const { return (i_totalTravelTime == 0 || i_timeElapsed >= i_totalTravelTime); }
+        bool _startNextPathSegment(TRAVELLER &traveller);
+        uint32 _getRemainingPathTime(TRAVELLER &traveller) const;
         void _findOffSetPoint(float x1, float y1, float x2, float y2, float offset, float &x, float &y);
 
 };
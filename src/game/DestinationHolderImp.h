@@ -63,14 +63,104 @@ DestinationHolder<TRAVELLER>::_findOffSetPoint(float x1, float y1, float x2, flo
 
 template<typename TRAVELLER>
 uint32
-DestinationHolder<TRAVELLER>::SetDestination(TRAVELLER &traveller, float dest_x, float dest_y, float dest_z, bool sendMove)
+DestinationHolder<TRAVELLER>::SetDestination(TRAVELLER &traveller, float dest_x, float dest_y, float dest_z, bool sendMove, bool usePath)
 {
+    usePath = usePath && traveller.UsePathfinding();
+
+    // chase/follow target moved a bit, keep path and move only its end point
+    bool keepPath = usePath && i_destSet && i_pathBuilt && PathFinder::IsSameNode(i_finalX, i_finalY, i_finalZ, dest_x, dest_y, dest_z);
+
     i_destSet = true;
+    i_finalX = dest_x;
+    i_finalY = dest_y;
+    i_finalZ = dest_z;
+
+    if (keepPath)
+    {
+        if (!i_path.empty())
+        {
+            SimplePathNode& end = i_path[i_path.size() - 1];
+            end.x = dest_x;
+            end.y = dest_y;
+            end.z = dest_z;
+
+            // current segment not end at moved point, continue it
+            if (i_pathIndex + 1 < i_path.size())
+            {
+                uint32 left = i_totalTravelTime > i_timeElapsed ? i_totalTravelTime - i_timeElapsed : 0;
+                return left + _getRemainingPathTime(traveller);
+            }
+        }
+
+        i_destX = dest_x;
+        i_destY = dest_y;
+        i_destZ = dest_z;
+
+        return StartTravel(traveller, sendMove);
+    }
+
+    i_path.clear();
+    i_pathIndex = 0;
+    i_pathBuilt = usePath;
+
+    if (usePath)
+    {
+        traveller.GetTraveller().GetMap()->GetPathFinder().BuildPath(traveller.GetPositionX(), traveller.GetPositionY(), traveller.GetPositionZ(),
+            dest_x, dest_y, dest_z, i_path);
+
+        // direct path not need segment by segment travel
+        if (i_path.size() > 2)
+        {
+            i_pathIndex = 1;
+            dest_x = i_path[i_pathIndex].x;
+            dest_y = i_path[i_pathIndex].y;
+            dest_z = i_path[i_pathIndex].z;
+        }
+        else
+            i_path.clear();
+    }
+
     i_destX = dest_x;
     i_destY = dest_y;
     i_destZ = dest_z;
 
-    return StartTravel(traveller, sendMove);
+    uint32 travelTime = StartTravel(traveller, sendMove);
+    return travelTime + _getRemainingPathTime(traveller);
+}
+
+template<typename TRAVELLER>
+uint32
+DestinationHolder<TRAVELLER>::_getRemainingPathTime(TRAVELLER &traveller) const
+{
+    // time for path segments after current
+    if (i_path.empty())
+        return 0;
+
+    double speed = traveller.Speed() * 0.001f;
+    if (speed <= 0.0f)
+        return 0;
+
+    return static_cast<uint32>(i_path.GetTotalLength(i_pathIndex, i_path.size()) / speed);
+}
+
+template<typename TRAVELLER>
+bool
+DestinationHolder<TRAVELLER>::_startNextPathSegment(TRAVELLER &traveller)
+{
+    if (i_pathIndex + 1 >= i_path.size())
+        return false;
+
+    ++i_pathIndex;
+
+    // finish previous segment exactly at path point, new segment started from it
+    traveller.Relocation(i_destX, i_destY, i_destZ, traveller.GetTraveller().GetAngle(i_path[i_pathIndex].x, i_path[i_pathIndex].y));
+
+    i_destX = i_path[i_pathIndex].x;
+    i_destY = i_path[i_pathIndex].y;
+    i_destZ = i_path[i_pathIndex].z;
+
+    StartTravel(traveller);
+    return true;
 }
 
 template<typename TRAVELLER>
@@ -103,6 +193,11 @@ DestinationHolder<TRAVELLER>::UpdateTraveller(TRAVELLER &traveller, uint32 diff,
     {
         i_tracker.Update(diff);
         i_timeElapsed += diff;
+
+        // path segment passed, continue with next path point in same update, so caller not see arrival at intermediate point
+        if (_segmentArrived() && _startNextPathSegment(traveller))
+            force_update = true;
+
         if (i_tracker.Passed() || force_update)
         {
             ResetUpdate();
@@ -123,6 +218,10 @@ DestinationHolder<TRAVELLER>::UpdateTraveller(TRAVELLER &traveller, uint32 diff,
     }
     i_tracker.Update(diff);
     i_timeElapsed += diff;
+
+    if (_segmentArrived() && _startNextPathSegment(traveller))
+        force_update = true;
+
     if (i_tracker.Passed() || force_update)
     {
         ResetUpdate();
@@ -164,7 +263,7 @@ template<typename TRAVELLER>
 void
 DestinationHolder<TRAVELLER>::GetLocationNow(const Map * map, float &x, float &y, float &z, bool is3D) const
 {
-    if (HasArrived())
+    if (_segmentArrived())
     {
         x = i_destX;
         y = i_destY;
@@ -201,21 +300,21 @@ DestinationHolder<TRAVELLER>::GetDistance3dFromDestSq(const WorldObject &obj) co
 {
     float x,y,z;
     obj.GetPosition(x,y,z);
-    return (i_destX-x)*(i_destX-x)+(i_destY-y)*(i_destY-y)+(i_destZ-z)*(i_destZ-z);
+    return (i_finalX-x)*(i_finalX-x)+(i_finalY-y)*(i_finalY-y)+(i_finalZ-z)*(i_finalZ-z);
 }
 
 template<typename TRAVELLER>
 float
 DestinationHolder<TRAVELLER>::GetDestinationDiff(float x, float y, float z) const
 {
-    return sqrt(((x-i_destX)*(x-i_destX)) + ((y-i_destY)*(y-i_destY)) + ((z-i_destZ)*(z-i_destZ)));
+    return sqrt(((x-i_finalX)*(x-i_finalX)) + ((y-i_finalY)*(y-i_finalY)) + ((z-i_finalZ)*(z-i_finalZ)));
 }
 
 template<typename TRAVELLER>
 void
 DestinationHolder<TRAVELLER>::GetLocationNowNoMicroMovement(float &x, float &y, float &z) const
 {
-    if (HasArrived())
+    if (_segmentArrived())
     {
         x = i_destX;
         y = i_destY;
@@ -19,6 +19,7 @@
 #include "QuestDef.h"
 #include "GossipDef.h"
 #include "ObjectMgr.h"
+#include "QueryResponseCache.h"
 #include "Opcodes.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -565,6 +566,14 @@ void PlayerMenu::SendQuestGiverQuestDetails( Quest const *pQuest, uint64 npcGUID
 // send only static data in this packet!
 void PlayerMenu::SendQuestQueryResponse( Quest const *pQuest )
 {
+    int loc_idx = GetMenuSession()->GetSessionDbLocaleIndex();
+    if (WorldPacket const* cached = sQueryResponseCache.Find(QUERY_CACHE_QUEST, pQuest->GetQuestId(), loc_idx))
+    {
+        GetMenuSession()->SendPacket(cached);
+        DEBUG_LOG("WORLD: Sent SMSG_QUEST_QUERY_RESPONSE questid=%u (cached)", pQuest->GetQuestId());
+        return;
+    }
+
     std::string Title, Details, Objectives, EndText, CompletedText;
     std::string ObjectiveText[QUEST_OBJECTIVES_COUNT];
     Title = pQuest->GetTitle();
@@ -576,7 +585,6 @@ void PlayerMenu::SendQuestQueryResponse( Quest const *pQuest )
     for (int i = 0; i < QUEST_OBJECTIVES_COUNT; ++i)
         ObjectiveText[i] = pQuest->ObjectiveText[i];
 
-    int loc_idx = GetMenuSession()->GetSessionDbLocaleIndex();
     if (loc_idx >= 0)
     {
         if (QuestLocale const *ql = sObjectMgr.GetQuestLocale(pQuest->GetQuestId()))
@@ -598,7 +606,7 @@ void PlayerMenu::SendQuestQueryResponse( Quest const *pQuest )
         }
     }
 
-    WorldPacket data( SMSG_QUEST_QUERY_RESPONSE, 100 );     // guess size
+    WorldPacket& data = sQueryResponseCache.Add(QUERY_CACHE_QUEST, pQuest->GetQuestId(), loc_idx, SMSG_QUEST_QUERY_RESPONSE, 100);
 
     data << uint32(pQuest->GetQuestId());                   // quest id
     data << uint32(pQuest->GetQuestMethod());               // Accepted values: 0, 1 or 2. 0==IsAutoComplete() (skip objectives/details)
@@ -36,36 +36,56 @@ VisibleChangesNotifier::Visit(CameraMapType &m)
     }
 }
 
+void
+VisibleNotifier::MarkInRange(WorldObject* obj)
+{
+    ++i_checks;
+
+    Player::ClientGUIDs::iterator itr = i_clientGUIDs.find(obj->GetObjectGuid());
+    if (itr != i_clientGUIDs.end())
+        itr->second = i_stamp;
+}
+
 void
 VisibleNotifier::Notify()
 {
     Player& player = *i_camera.GetOwner();
-    // at this moment i_clientGUIDs have guids that not iterate at grid level checks
+    // at this moment not marked client guids are objects that not iterate at grid level checks
     // but exist one case when this possible and object not out of range: transports
     if(Transport* transport = player.GetTransport())
     {
         for(Transport::PlayerSet::const_iterator itr = transport->GetPassengers().begin();itr!=transport->GetPassengers().end();++itr)
         {
-            if (i_clientGUIDs.find((*itr)->GetGUID()) != i_clientGUIDs.end())
+            Player::ClientGUIDs::const_iterator cItr = i_clientGUIDs.find((*itr)->GetObjectGuid());
+            if (cItr != i_clientGUIDs.end() && cItr->second != i_stamp)
             {
                 // ignore far sight case
                 (*itr)->UpdateVisibilityOf(*itr, &player);
                 player.UpdateVisibilityOf(&player, *itr, i_data, i_visibleNow);
-                i_clientGUIDs.erase((*itr)->GetGUID());
+                MarkInRange(*itr);
             }
         }
     }
 
     // generate outOfRange for not iterate objects
-    i_data.AddOutOfRangeGUID(i_clientGUIDs);
-    for(ObjectGuidSet::iterator itr = i_clientGUIDs.begin();itr!=i_clientGUIDs.end();++itr)
+    for(Player::ClientGUIDs::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
     {
-        player.m_clientGUIDs.erase(*itr);
+        if (itr->second == i_stamp)
+        {
+            ++itr;
+            continue;
+        }
+
+        i_data.AddOutOfRangeGUID(itr->first);
 
         DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "%s is out of range (no in active cells set) now for %s",
-            itr->GetString().c_str(), player.GetObjectGuid().GetString().c_str());
+            itr->first.GetString().c_str(), player.GetObjectGuid().GetString().c_str());
+
+        i_clientGUIDs.erase(itr++);
     }
 
+    player.GetMap()->AddVisibilityChecks(i_checks);
+
     if (i_data.HasData())
     {
         // send create/outofrange packet to player (except player create updates that already sent using SendUpdateToPlayer)
@@ -127,6 +147,12 @@ void MessageDelivererExcept::Visit(CameraMapType &m)
         if (!owner->InSamePhase(i_phaseMask) || owner == i_skipped_receiver)
             continue;
 
+        if (i_maxDist > 0.0f && !iter->getSource()->GetBody()->IsWithinDist(i_object, i_maxDist))
+            continue;
+
+        if (i_knownOnly && !owner->HaveAtClient(i_object))
+            continue;
+
         if (WorldSession* session = owner->GetSession())
             session->SendPacket(i_message);
     }
@@ -191,6 +217,22 @@ ObjectUpdater::Visit(GridRefManager<T> &m)
     }
 }
 
+bool ObjectUpdater::IsInSightOfViewers(WorldObject const* obj) const
+{
+    if (!i_cellViewers)
+        return false;
+
+    for (CellViewerRangeList::const_iterator itr = i_cellViewers->begin(); itr != i_cellViewers->end(); ++itr)
+    {
+        float dx = obj->GetPositionX() - itr->x;
+        float dy = obj->GetPositionY() - itr->y;
+        if (dx*dx + dy*dy <= itr->range * itr->range)
+            return true;
+    }
+
+    return false;
+}
+
 bool CannibalizeObjectCheck::operator()(Corpse* u)
 {
     // ignore bones
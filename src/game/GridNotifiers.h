@@ -40,11 +40,14 @@ namespace MaNGOS
     {
         Camera& i_camera;
         UpdateData i_data;
-        ObjectGuidSet i_clientGUIDs;
+        Player::ClientGUIDs& i_clientGUIDs;
+        uint32 i_stamp;                                     // client guids marked by it are still in range
+        uint32 i_checks;
         std::set<WorldObject*> i_visibleNow;
 
-        explicit VisibleNotifier(Camera &c) : i_camera(c), i_clientGUIDs(c.GetOwner()->m_clientGUIDs) {}
+        explicit VisibleNotifier(Camera &c) : i_camera(c), i_clientGUIDs(c.GetOwner()->m_clientGUIDs), i_stamp(c.GetVisibilityStamp()), i_checks(0) {}
         template<class T> void Visit(GridRefManager<T> &m);
+        void MarkInRange(WorldObject* obj);
         void Visit(CameraMapType &m) {}
         void Notify(void);
     };
@@ -92,9 +95,12 @@ namespace MaNGOS
         uint32        i_phaseMask;
         WorldPacket*  i_message;
         Player const* i_skipped_receiver;
+        WorldObject const* i_object;
+        float i_maxDist;                                    // camera distance limit, 0 if not limited
+        bool i_knownOnly;                                   // skip players that not have object at client
 
-        MessageDelivererExcept(WorldObject const* obj, WorldPacket *msg, Player const* skipped)
-            : i_phaseMask(obj->GetPhaseMask()), i_message(msg), i_skipped_receiver(skipped) {}
+        MessageDelivererExcept(WorldObject const* obj, WorldPacket *msg, Player const* skipped, float maxDist = 0.0f, bool knownOnly = false)
+            : i_phaseMask(obj->GetPhaseMask()), i_message(msg), i_skipped_receiver(skipped), i_object(obj), i_maxDist(maxDist), i_knownOnly(knownOnly) {}
 
         void Visit(CameraMapType &m);
         template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
@@ -137,7 +143,12 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL ObjectUpdater
     {
         uint32 i_timeDiff;
-        explicit ObjectUpdater(const uint32 &diff) : i_timeDiff(diff) {}
+        bool i_dormantAllowed;                              // idle creatures out of sight of all players skipped
+        bool i_cellInSight;                                 // visited cell fully in visibility range of some player
+        CellViewerRangeList const* i_cellViewers;           // players with visibility range partly covering visited cell, can be NULL
+        uint32 i_dormantSkipped;
+        explicit ObjectUpdater(const uint32 &diff) : i_timeDiff(diff), i_dormantAllowed(false), i_cellInSight(true), i_cellViewers(NULL), i_dormantSkipped(0) {}
+        bool IsInSightOfViewers(WorldObject const* obj) const;
         template<class T> void Visit(GridRefManager<T> &m);
         void Visit(PlayerMapType &) {}
         void Visit(CorpseMapType &) {}
@@ -145,10 +156,12 @@ namespace MaNGOS
         void Visit(CreatureMapType &);
     };
 
+    // notifyPass != 0 for Map::ProcessRelocationNotifies calls, pairs with units already processed in same pass skipped
     struct MANGOS_DLL_DECL PlayerRelocationNotifier
     {
         Player &i_player;
-        PlayerRelocationNotifier(Player &pl) : i_player(pl) {}
+        uint32 i_notifyPass;
+        PlayerRelocationNotifier(Player &pl, uint32 notifyPass = 0) : i_player(pl), i_notifyPass(notifyPass) {}
         template<class T> void Visit(GridRefManager<T> &) {}
         void Visit(PlayerMapType &);
         void Visit(CreatureMapType &);
@@ -157,7 +170,8 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL CreatureRelocationNotifier
     {
         Creature &i_creature;
-        CreatureRelocationNotifier(Creature &c) : i_creature(c) {}
+        uint32 i_notifyPass;
+        CreatureRelocationNotifier(Creature &c, uint32 notifyPass = 0) : i_creature(c), i_notifyPass(notifyPass) {}
         template<class T> void Visit(GridRefManager<T> &) {}
         #ifdef WIN32
         template<> void Visit(PlayerMapType &);
@@ -370,6 +384,7 @@ namespace MaNGOS
 
         void Visit(PlayerMapType &m);
         void Visit(CreatureMapType &m);
+        void VisitUnit(Unit* u);                            // for UnitSpatialIndex
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
     };
@@ -669,6 +684,15 @@ namespace MaNGOS
 
     // Unit checks
 
+    // checks by IsWithinDistInMap(u, range) accept only units in this 2d area (+unit bounding radius)
+    inline bool GetObjectRangeArea(WorldObject const* obj, float range, float& x, float& y, float& radius)
+    {
+        x = obj->GetPositionX();
+        y = obj->GetPositionY();
+        radius = range + obj->GetObjectBoundingRadius();
+        return true;
+    }
+
     class MostHPMissingInRange
     {
         public:
@@ -736,6 +760,11 @@ namespace MaNGOS
                 else
                     return false;
             }
+
+            friend bool GetUnitCheckArea(AnyUnfriendlyUnitInObjectRangeCheck const& check, float& x, float& y, float& radius)
+            {
+                return GetObjectRangeArea(check.i_obj, check.i_range, x, y, radius);
+            }
         private:
             WorldObject const* i_obj;
             Unit const* i_funit;
@@ -755,6 +784,11 @@ namespace MaNGOS
                     && !i_funit->IsFriendlyTo(u)
                     && u->isVisibleForOrDetect(i_funit,i_funit,false);
             }
+
+            friend bool GetUnitCheckArea(AnyUnfriendlyVisibleUnitInObjectRangeCheck const& check, float& x, float& y, float& radius)
+            {
+                return GetObjectRangeArea(check.i_obj, check.i_range, x, y, radius);
+            }
         private:
             WorldObject const* i_obj;
             Unit const* i_funit;
@@ -772,6 +806,11 @@ namespace MaNGOS
                 else
                     return false;
             }
+
+            friend bool GetUnitCheckArea(AnyFriendlyUnitInObjectRangeCheck const& check, float& x, float& y, float& radius)
+            {
+                return GetObjectRangeArea(check.i_obj, check.i_range, x, y, radius);
+            }
         private:
             WorldObject const* i_obj;
             float i_range;
@@ -846,6 +885,11 @@ namespace MaNGOS
 
                 return false;
             }
+
+            friend bool GetUnitCheckArea(AnyAoEVisibleTargetUnitInObjectRangeCheck const& check, float& x, float& y, float& radius)
+            {
+                return GetObjectRangeArea(check.i_obj, check.i_range, x, y, radius);
+            }
         private:
             bool i_targetForUnit;
             bool i_targetForPlayer;
@@ -878,6 +922,11 @@ namespace MaNGOS
                 return false;
             }
 
+
+            friend bool GetUnitCheckArea(AnyAoETargetUnitInObjectRangeCheck const& check, float& x, float& y, float& radius)
+            {
+                return GetObjectRangeArea(check.i_obj, check.i_range, x, y, radius);
+            }
         private:
             bool i_targetForPlayer;
             WorldObject const* i_obj;
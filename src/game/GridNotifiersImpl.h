@@ -34,14 +34,24 @@ inline void MaNGOS::VisibleNotifier::Visit(GridRefManager<T> &m)
     for(typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         i_camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
-        i_clientGUIDs.erase(iter->getSource()->GetGUID());
+        MarkInRange(iter->getSource());
     }
 }
 
 inline void MaNGOS::ObjectUpdater::Visit(CreatureMapType &m)
 {
     for(CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        iter->getSource()->Update(i_timeDiff);
+    {
+        Creature* creature = iter->getSource();
+        if (!i_cellInSight && creature->GetActivity() == CREATURE_ACTIVITY_IDLE && !IsInSightOfViewers(creature))
+        {
+            creature->AddDormantTime(i_timeDiff);
+            ++i_dormantSkipped;
+            continue;
+        }
+
+        creature->Update(i_timeDiff);
+    }
 }
 
 inline void MaNGOS::PlayerRelocationNotifier::Visit(PlayerMapType &m)
@@ -61,6 +71,12 @@ inline void MaNGOS::PlayerRelocationNotifier::Visit(PlayerMapType &m)
     }
 }
 
+// pair already processed from other side in current Map::ProcessRelocationNotifies pass
+inline bool IsRelocationNotifiedInPass(Unit const* u, uint32 notifyPass)
+{
+    return notifyPass && u->GetRelocationNotifyState().pass == notifyPass;
+}
+
 inline void PlayerCreatureRelocationWorker(Player* pl, WorldObject const* viewPoint, Creature* c)
 {
     // update creature visibility at player/creature move
@@ -97,7 +113,7 @@ inline void MaNGOS::PlayerRelocationNotifier::Visit(CreatureMapType &m)
     WorldObject const* viewPoint = i_player.GetCamera().GetBody();
 
     for(CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if (iter->getSource()->isAlive())
+        if (iter->getSource()->isAlive() && !IsRelocationNotifiedInPass(iter->getSource(), i_notifyPass))
             PlayerCreatureRelocationWorker(&i_player, viewPoint, iter->getSource());
 }
 
@@ -109,7 +125,7 @@ inline void MaNGOS::CreatureRelocationNotifier::Visit(PlayerMapType &m)
 
     for(PlayerMapType::iterator iter=m.begin(); iter != m.end(); ++iter)
         if (Player* player = iter->getSource())
-            if (player->isAlive() && !player->IsTaxiFlying())
+            if (player->isAlive() && !player->IsTaxiFlying() && !IsRelocationNotifiedInPass(player, i_notifyPass))
                 PlayerCreatureRelocationWorker(player, player->GetCamera().GetBody(), &i_creature);
 }
 
@@ -122,7 +138,7 @@ inline void MaNGOS::CreatureRelocationNotifier::Visit(CreatureMapType &m)
     for(CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Creature* c = iter->getSource();
-        if (c != &i_creature && c->isAlive())
+        if (c != &i_creature && c->isAlive() && !IsRelocationNotifiedInPass(c, i_notifyPass))
             CreatureCreatureRelocationWorker(c, &i_creature);
     }
 }
@@ -500,6 +516,14 @@ void MaNGOS::UnitListSearcher<Check>::Visit(CreatureMapType &m)
                 i_objects.push_back(itr->getSource());
 }
 
+template<class Check>
+void MaNGOS::UnitListSearcher<Check>::VisitUnit(Unit* u)
+{
+    if (u->InSamePhase(i_phaseMask))
+        if (i_check(u))
+            i_objects.push_back(u);
+}
+
 // Creature searchers
 
 template<class Check>
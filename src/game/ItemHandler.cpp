@@ -22,6 +22,7 @@
 #include "Opcodes.h"
 #include "Log.h"
 #include "ObjectMgr.h"
+#include "QueryResponseCache.h"
 #include "Player.h"
 #include "Item.h"
 #include "UpdateData.h"
@@ -288,10 +289,16 @@ void WorldSession::HandleItemQuerySingleOpcode( WorldPacket & recv_data )
     ItemPrototype const *pProto = ObjectMgr::GetItemPrototype( item );
     if( pProto )
     {
+        int loc_idx = GetSessionDbLocaleIndex();
+        if (WorldPacket const* cached = sQueryResponseCache.Find(QUERY_CACHE_ITEM, item, loc_idx))
+        {
+            SendPacket(cached);
+            return;
+        }
+
         std::string Name        = pProto->Name1;
         std::string Description = pProto->Description;
 
-        int loc_idx = GetSessionDbLocaleIndex();
         if ( loc_idx >= 0 )
         {
             ItemLocale const *il = sObjectMgr.GetItemLocale(pProto->ItemId);
@@ -304,7 +311,7 @@ void WorldSession::HandleItemQuerySingleOpcode( WorldPacket & recv_data )
             }
         }
                                                             // guess size
-        WorldPacket data( SMSG_ITEM_QUERY_SINGLE_RESPONSE, 600);
+        WorldPacket& data = sQueryResponseCache.Add(QUERY_CACHE_ITEM, item, loc_idx, SMSG_ITEM_QUERY_SINGLE_RESPONSE, 600);
         data << pProto->ItemId;
         data << pProto->Class;
         data << pProto->SubClass;
@@ -564,6 +564,7 @@ bool ChatHandler::HandleReloadSpellChainCommand(char* /*args*/)
 {
     sLog.outString( "Re-Loading Spell Chain Data... " );
     sSpellMgr.LoadSpellChains();
+    sSpellMgr.LoadSpellInfoTable();
     SendGlobalSysMessage("DB table `spell_chain` (spell ranks) reloaded.");
     return true;
 }
@@ -572,6 +573,7 @@ bool ChatHandler::HandleReloadSpellElixirCommand(char* /*args*/)
 {
     sLog.outString( "Re-Loading Spell Elixir types..." );
     sSpellMgr.LoadSpellElixirs();
+    sSpellMgr.LoadSpellInfoTable();
     SendGlobalSysMessage("DB table `spell_elixir` (spell elixir types) reloaded.");
     return true;
 }
@@ -4239,6 +4241,7 @@ void ChatHandler::HandleCharacterLevel(Player* player, uint64 player_guid, uint3
     {
         // update level and XP at level, all other will be updated at loading
         CharacterDatabase.PExecute("UPDATE characters SET level = '%u', xp = 0 WHERE guid = '%u'", newlevel, GUID_LOPART(player_guid));
+        sObjectMgr.UpdateCharacterLevel(player_guid, newlevel);
     }
 }
 
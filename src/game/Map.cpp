@@ -38,6 +38,7 @@
 #include "InstanceSaveMgr.h"
 #include "VMapFactory.h"
 #include "BattleGroundMgr.h"
+#include "UnitSpatialIndex.h"
 
 struct ScriptAction
 {
@@ -57,6 +58,8 @@ Map::~Map()
 
     if (m_instanceSave)
         m_instanceSave->SetUsedByMapState(false);           // field pointer can be deleted after this
+
+    delete m_unitIndex;
 }
 
 void Map::LoadVMap(int gx,int gy)
@@ -131,7 +134,9 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _par
   i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0),
   m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_instanceSave(NULL),
   m_activeNonPlayersIter(m_activeNonPlayers.end()),
-  i_gridExpiry(expiry), m_parentMap(_parent ? _parent : this)
+  i_gridExpiry(expiry), m_parentMap(_parent ? _parent : this), m_pathFinder(this), m_unitIndex(NULL), m_relocationNotifyPass(0),
+  m_visibilityUpdatesTick(0), m_visibilityChecksTick(0), m_lastVisibilityUpdates(0), m_lastVisibilityChecks(0), m_lastDormantSkips(0),
+  m_lodNearDistance(0.0f), m_lodMidDistance(0.0f), m_crowdUpdateTimer(0)
 {
     for(unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
     {
@@ -146,6 +151,15 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _par
 
     //lets initialize visibility distance for map
     Map::InitVisibilityDistance();
+
+    if (float cellSize = sWorld.getConfig(CONFIG_FLOAT_SPATIAL_INDEX_CELL_SIZE))
+        m_unitIndex = new UnitSpatialIndex(cellSize);
+
+    if (MapVisibilityLOD const* lod = sWorld.GetMapVisibilityLOD(id))
+    {
+        m_lodNearDistance = lod->nearDistance;
+        m_lodMidDistance = lod->midDistance;
+    }
 }
 
 void Map::InitVisibilityDistance()
@@ -154,6 +168,103 @@ void Map::InitVisibilityDistance()
     m_VisibleDistance = World::GetMaxVisibleDistanceOnContinents();
 }
 
+uint32 Map::GetCrowdRegionKey(float x, float y)
+{
+    CellPair p = MaNGOS::ComputeCellPair(x, y);
+    return ((p.x_coord / CROWD_REGION_CELLS) << 16) | (p.y_coord / CROWD_REGION_CELLS);
+}
+
+float Map::GetVisibilityDistance(WorldObject const* viewPoint) const
+{
+    if (m_crowdRegions.empty())
+        return m_VisibleDistance;
+
+    CrowdRegionMap::const_iterator itr = m_crowdRegions.find(GetCrowdRegionKey(viewPoint->GetPositionX(), viewPoint->GetPositionY()));
+    return itr != m_crowdRegions.end() ? itr->second : m_VisibleDistance;
+}
+
+void Map::UpdateCrowdVisibility()
+{
+    uint32 threshold = sWorld.getConfig(CONFIG_UINT32_VISIBILITY_CROWD_THRESHOLD);
+    if (!threshold && m_crowdRegions.empty())
+        return;
+
+    // players count in regions
+    typedef UNORDERED_MAP<uint32, uint32> RegionPlayers;
+    RegionPlayers regionPlayers;
+    if (threshold)
+    {
+        for(MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+        {
+            Player* plr = itr->getSource();
+            if (plr->IsInWorld())
+                ++regionPlayers[GetCrowdRegionKey(plr->GetPositionX(), plr->GetPositionY())];
+        }
+    }
+
+    float maxDist = sWorld.getConfig(CONFIG_FLOAT_VISIBILITY_CROWD_MAX_DISTANCE);
+    if (maxDist <= 0.0f || maxDist > m_VisibleDistance)
+        maxDist = m_VisibleDistance;
+    float minDist = std::min(sWorld.getConfig(CONFIG_FLOAT_VISIBILITY_CROWD_MIN_DISTANCE), maxDist);
+    float hysteresis = sWorld.getConfig(CONFIG_FLOAT_VISIBILITY_CROWD_HYSTERESIS);
+
+    std::set<uint32> changedRegions;
+
+    // regions without players (or all at crowd mode disable), far sight cameras can be still there
+    for(CrowdRegionMap::iterator itr = m_crowdRegions.begin(); itr != m_crowdRegions.end();)
+    {
+        if (regionPlayers.find(itr->first) == regionPlayers.end())
+        {
+            changedRegions.insert(itr->first);
+            m_crowdRegions.erase(itr++);
+        }
+        else
+            ++itr;
+    }
+
+    for(RegionPlayers::const_iterator itr = regionPlayers.begin(); itr != regionPlayers.end(); ++itr)
+    {
+        // visible players count grows with square of distance, keep it near threshold
+        float target = m_VisibleDistance;
+        if (itr->second > threshold)
+            target = std::max(minDist, std::min(maxDist, m_VisibleDistance * sqrt(float(threshold) / itr->second)));
+
+        CrowdRegionMap::iterator rItr = m_crowdRegions.find(itr->first);
+        float current = rItr != m_crowdRegions.end() ? rItr->second : m_VisibleDistance;
+
+        if (target == current)
+            continue;
+
+        // small density changes between two reduced distances ignored, so visibility not flapping at moves
+        // around region, but return to full distance and distance out of (changed) limits applied always
+        if (target != m_VisibleDistance && current != m_VisibleDistance && current >= minDist && current <= maxDist &&
+            fabs(target - current) < hysteresis)
+            continue;
+
+        changedRegions.insert(itr->first);
+
+        if (target == m_VisibleDistance)
+            m_crowdRegions.erase(rItr);
+        else
+            m_crowdRegions[itr->first] = target;
+    }
+
+    if (changedRegions.empty())
+        return;
+
+    // removed at client objects out of new range, or added objects in new range
+    for(MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* plr = itr->getSource();
+        if (!plr->IsInWorld())
+            continue;
+
+        WorldObject* body = plr->GetCamera().GetBody();
+        if (changedRegions.find(GetCrowdRegionKey(body->GetPositionX(), body->GetPositionY())) != changedRegions.end())
+            plr->GetCamera().ScheduleVisibilityUpdate();
+    }
+}
+
 // Template specialization of utility methods
 template<class T>
 void Map::AddToGrid(T* obj, NGridType *grid, Cell const& cell)
@@ -263,13 +374,13 @@ void Map::AddNotifier(T* , Cell const& , CellPair const& )
 template<>
 void Map::AddNotifier(Player* obj, Cell const& cell, CellPair const& cellpair)
 {
-    PlayerRelocationNotify(obj,cell,cellpair);
+    ScheduleRelocationNotify(obj, true);
 }
 
 template<>
 void Map::AddNotifier(Creature* obj, Cell const&, CellPair const&)
 {
-    obj->SetNeedNotify();
+    ScheduleRelocationNotify(obj, true);
 }
 
 void
@@ -510,20 +621,29 @@ bool Map::loaded(const GridPair &p) const
     return ( getNGrid(p.x_coord, p.y_coord) && isGridObjectDataLoaded(p.x_coord, p.y_coord) );
 }
 
-void Map::Update(const uint32 &t_diff)
+void Map::ScheduleRespawn(Creature* creature, time_t respawnTime)
 {
-    /// update players at tick
-    for(m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    m_respawnQueue.push(respawnTime, creature->GetObjectGuid());
+}
+
+void Map::ProcessRespawnQueue()
+{
+    time_t now = time(NULL);
+
+    // respawn can add creature to map and schedule new entries, so top rechecked for each entry
+    while (!m_respawnQueue.empty() && m_respawnQueue.top().time <= now)
     {
-        Player* plr = m_mapRefIter->getSource();
-        if(plr && plr->IsInWorld())
-            plr->Update(t_diff);
-    }
+        ObjectGuid guid = m_respawnQueue.top().value;
+        m_respawnQueue.pop();
 
-    /// update active cells around players and active objects
-    resetMarkedCells();
+        // not found if grid unloaded, creature scheduled again at load
+        if (Creature* creature = GetAnyTypeCreature(guid))
+            creature->UpdateRespawn(now);
+    }
+}
 
-    MaNGOS::ObjectUpdater updater(t_diff);
+void Map::UpdateCellsAroundPlayers(MaNGOS::ObjectUpdater& updater, float radius)
+{
     // for creature
     TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
     // for pets
@@ -547,8 +667,8 @@ void Map::Update(const uint32 &t_diff)
         // the overloaded operators handle range checking
         // so ther's no need for range checking inside the loop
         CellPair begin_cell(standing_cell), end_cell(standing_cell);
-        //lets update mobs/objects in ALL visible cells around player!
-        CellArea area = Cell::CalculateCellArea(*plr, GetVisibilityDistance());
+        //lets update mobs/objects in ALL cells in radius around player!
+        CellArea area = Cell::CalculateCellArea(*plr, radius);
         area.ResizeBorders(begin_cell, end_cell);
 
         for(uint32 x = begin_cell.x_coord; x <= end_cell.x_coord; ++x)
@@ -561,6 +681,13 @@ void Map::Update(const uint32 &t_diff)
                 if(!isCellMarked(cell_id))
                 {
                     markCell(cell_id);
+                    if (updater.i_dormantAllowed)
+                    {
+                        CellViewersMap::const_iterator vItr = m_cellViewers.find(cell_id);
+                        updater.i_cellInSight = m_cellsInSight.test(cell_id);
+                        updater.i_cellViewers = vItr != m_cellViewers.end() ? &vItr->second : NULL;
+                    }
+
                     CellPair pair(x,y);
                     Cell cell(pair);
                     cell.data.Part.reserved = CENTER_DISTRICT;
@@ -571,8 +698,87 @@ void Map::Update(const uint32 &t_diff)
             }
         }
     }
+}
+
+// cells fully in visibility range of some player and players partly seeing other cells,
+// computed once per update from player areas instead of check all players for each cell
+void Map::ClassifyCellsInSight()
+{
+    m_cellsInSight.reset();
+    m_cellViewers.clear();
+
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* plr = itr->getSource();
+        if (!plr->IsInWorld())
+            continue;
+
+        CellPair standing_cell(MaNGOS::ComputeCellPair(plr->GetPositionX(), plr->GetPositionY()));
+        if (standing_cell.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || standing_cell.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+            continue;
+
+        CellViewerRange viewer;
+        viewer.x = plr->GetPositionX();
+        viewer.y = plr->GetPositionY();
+        viewer.range = GetVisibilityDistance(plr) + World::GetVisibleUnitGreyDistance();
+
+        CellPair begin_cell(standing_cell), end_cell(standing_cell);
+        CellArea area = Cell::CalculateCellArea(*plr, viewer.range);
+        area.ResizeBorders(begin_cell, end_cell);
+
+        for (uint32 x = begin_cell.x_coord; x <= end_cell.x_coord; ++x)
+        {
+            for (uint32 y = begin_cell.y_coord; y <= end_cell.y_coord; ++y)
+            {
+                uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+                if (m_cellsInSight.test(cell_id))
+                    continue;
+
+                float minX = (int32(x) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+                float minY = (int32(y) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+                float maxX = minX + SIZE_OF_GRID_CELL;
+                float maxY = minY + SIZE_OF_GRID_CELL;
+
+                // nearest cell point to player
+                float nx = viewer.x - std::max(minX, std::min(viewer.x, maxX));
+                float ny = viewer.y - std::max(minY, std::min(viewer.y, maxY));
+                if (nx*nx + ny*ny > viewer.range*viewer.range)
+                    continue;
+
+                // farthest cell corner to player
+                float fx = std::max(viewer.x - minX, maxX - viewer.x);
+                float fy = std::max(viewer.y - minY, maxY - viewer.y);
+                if (fx*fx + fy*fy <= viewer.range*viewer.range)
+                    m_cellsInSight.set(cell_id);
+                else
+                    m_cellViewers[cell_id].push_back(viewer);
+            }
+        }
+    }
+}
+
+void Map::Update(const uint32 &t_diff)
+{
+    /// update players at tick
+    for(m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    {
+        Player* plr = m_mapRefIter->getSource();
+        if(plr && plr->IsInWorld())
+            plr->Update(t_diff);
+    }
+
+    ProcessRespawnQueue();
+
+    /// update active cells around players and active objects
+    resetMarkedCells();
+
+    MaNGOS::ObjectUpdater updater(t_diff);
+    // for creature
+    TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+    // for pets
+    TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
-    // non-player active objects
+    // cells around non-player active objects updated first and fully, creatures there not dormant
     if(!m_activeNonPlayers.empty())
     {
         for(m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end(); )
@@ -621,9 +827,43 @@ void Map::Update(const uint32 &t_diff)
         }
     }
 
+    // idle creatures out of sight of all players can be skipped
+    updater.i_dormantAllowed = sWorld.getConfig(CONFIG_BOOL_CREATURE_DORMANT_OUT_OF_SIGHT);
+    if (updater.i_dormantAllowed)
+        ClassifyCellsInSight();
+    UpdateCellsAroundPlayers(updater, GetVisibilityDistance());
+
+    m_lastDormantSkips = updater.i_dormantSkipped;
+
+    if (m_crowdUpdateTimer <= t_diff)
+    {
+        UpdateCrowdVisibility();
+        m_crowdUpdateTimer = sWorld.getConfig(CONFIG_UINT32_VISIBILITY_CROWD_UPDATE_INTERVAL);
+    }
+    else
+        m_crowdUpdateTimer -= t_diff;
+
+    // after all players and creatures moved in tick
+    ProcessRelocationNotifies();
+
+    // scheduled at relocations visibility updates
+    for(MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* plr = itr->getSource();
+        if (plr->IsInWorld())
+            plr->GetCamera().UpdateVisibilityTimer(t_diff);
+    }
+
+    m_lastVisibilityUpdates = m_visibilityUpdatesTick;
+    m_lastVisibilityChecks = m_visibilityChecksTick;
+    m_visibilityUpdatesTick = 0;
+    m_visibilityChecksTick = 0;
+
     // Send world objects and item update field changes
     SendObjectUpdates();
 
+    m_pathFinder.Update(t_diff);
+
     // Don't unload grids if it's battleground, since we may have manually added GOs,creatures, those doesn't load from DB at grid re-load !
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
     if (!IsBattleGroundOrArena())
@@ -766,10 +1006,10 @@ Map::PlayerRelocation(Player *player, float x, float y, float z, float orientati
         player->GetViewPoint().Event_GridChanged(&(*newGrid)(new_cell.CellX(),new_cell.CellY()));
     }
 
-    player->GetViewPoint().Call_UpdateVisibilityForOwner();
+    player->GetViewPoint().Call_ScheduleVisibilityUpdate();
     // if move then update what player see and who seen
     UpdateObjectVisibility(player, new_cell, new_val);
-    PlayerRelocationNotify(player,new_cell,new_val);
+    ScheduleRelocationNotify(player, false);
 
     NGridType* newGrid = getNGrid(new_cell.GridX(), new_cell.GridY());
     if( !same_cell && newGrid->GetGridState()!= GRID_STATE_ACTIVE )
@@ -800,8 +1040,7 @@ Map::CreatureRelocation(Creature *creature, float x, float y, float z, float ang
             // update pos
             creature->Relocate(x, y, z, ang);
 
-            // in diffcell/diffgrid case notifiers called in Creature::Update
-            creature->SetNeedNotify();
+            ScheduleRelocationNotify(creature, false);
         }
         else
         {
@@ -811,17 +1050,17 @@ Map::CreatureRelocation(Creature *creature, float x, float y, float z, float ang
             {
                 // ... or unload (if respawn grid also not loaded)
                 DEBUG_FILTER_LOG(LOG_FILTER_CREATURE_MOVES, "Creature (GUID: %u Entry: %u ) can't be move to unloaded respawn grid.",creature->GetGUIDLow(),creature->GetEntry());
-                creature->SetNeedNotify();
+                ScheduleRelocationNotify(creature, true);
             }
         }
     }
     else
     {
         creature->Relocate(x, y, z, ang);
-        creature->SetNeedNotify();
+        ScheduleRelocationNotify(creature, false);
     }
 
-    creature->GetViewPoint().Call_UpdateVisibilityForOwner();
+    creature->GetViewPoint().Call_ScheduleVisibilityUpdate();
     ASSERT(CheckGridIntegrity(creature,true));
 }
 
@@ -905,7 +1144,7 @@ bool Map::CreatureRespawnRelocation(Creature *c)
     {
         c->Relocate(resp_x, resp_y, resp_z, resp_o);
         c->GetMotionMaster()->Initialize();                 // prevent possible problems with default move generators
-        c->SetNeedNotify();
+        ScheduleRelocationNotify(c, true);
         return true;
     }
     else
@@ -1328,11 +1567,14 @@ void Map::UpdateObjectVisibility( WorldObject* obj, Cell cell, CellPair cellpair
     cell.Visit(cellpair, player_notifier, *this, *obj, GetVisibilityDistance());
 }
 
-void Map::PlayerRelocationNotify( Player* player, Cell cell, CellPair cellpair )
+void Map::PlayerRelocationNotify(Player* player, uint32 notifyPass)
 {
-    MaNGOS::PlayerRelocationNotifier relocationNotifier(*player);
+    CellPair cellpair = MaNGOS::ComputeCellPair(player->GetPositionX(), player->GetPositionY());
+    Cell cell(cellpair);
     cell.data.Part.reserved = ALL_DISTRICT;
 
+    MaNGOS::PlayerRelocationNotifier relocationNotifier(*player, notifyPass);
+
     TypeContainerVisitor<MaNGOS::PlayerRelocationNotifier, GridTypeMapContainer >  p2grid_relocation(relocationNotifier);
     TypeContainerVisitor<MaNGOS::PlayerRelocationNotifier, WorldTypeMapContainer > p2world_relocation(relocationNotifier);
 
@@ -1342,6 +1584,75 @@ void Map::PlayerRelocationNotify( Player* player, Cell cell, CellPair cellpair )
     cell.Visit(cellpair, p2world_relocation, *this, *player, radius);
 }
 
+void Map::ScheduleRelocationNotify(Unit* unit, bool force)
+{
+    RelocationNotifyState& state = unit->GetRelocationNotifyState();
+
+    if (force)
+        state.forced = true;
+
+    if (state.queued)
+        return;
+
+    state.queued = true;
+    m_relocationNotifyQueue.push_back(unit->GetObjectGuid());
+}
+
+void Map::ProcessRelocationNotifies()
+{
+    if (m_relocationNotifyQueue.empty())
+        return;
+
+    // 0 used as "not processed" mark
+    if (++m_relocationNotifyPass == 0)
+        m_relocationNotifyPass = 1;
+
+    float minDist = sWorld.getConfig(CONFIG_FLOAT_RELOCATION_LOWER_LIMIT);
+    uint32 maxDelay = sWorld.getConfig(CONFIG_UINT32_RELOCATION_NOTIFY_DELAY);
+    uint32 now = getMSTime();
+
+    // notifier reactions can schedule new notifies, and small moves stay queued for next ticks
+    std::vector<ObjectGuid> queue;
+    queue.swap(m_relocationNotifyQueue);
+
+    for (std::vector<ObjectGuid>::const_iterator itr = queue.begin(); itr != queue.end(); ++itr)
+    {
+        Unit* unit = GetUnit(*itr);
+        if (!unit || !unit->IsInWorld())
+            continue;
+
+        RelocationNotifyState& state = unit->GetRelocationNotifyState();
+        if (!state.queued)                                  // removed from world and re-added meantime, double queued
+            continue;
+
+        if (!state.forced && getMSTimeDiff(state.lastTime, now) < maxDelay)
+        {
+            float dx = unit->GetPositionX() - state.x;
+            float dy = unit->GetPositionY() - state.y;
+            float dz = unit->GetPositionZ() - state.z;
+            if (dx*dx + dy*dy + dz*dz < minDist*minDist)
+            {
+                m_relocationNotifyQueue.push_back(*itr);
+                continue;
+            }
+        }
+
+        state.queued = false;
+        state.forced = false;
+        state.x = unit->GetPositionX();
+        state.y = unit->GetPositionY();
+        state.z = unit->GetPositionZ();
+        state.lastTime = now;
+        // set before call, so units notified later in pass skip pairs with this unit
+        state.pass = m_relocationNotifyPass;
+
+        if (unit->GetTypeId() == TYPEID_PLAYER)
+            PlayerRelocationNotify((Player*)unit, m_relocationNotifyPass);
+        else
+            ((Creature*)unit)->RelocationNotify(m_relocationNotifyPass);
+    }
+}
+
 void Map::SendInitSelf( Player * player )
 {
     DETAIL_LOG("Creating player data for himself %u", player->GetGUIDLow());
@@ -3030,13 +3341,33 @@ void Map::SendObjectUpdates()
 {
     UpdateDataMapType update_players;
 
+    // objects with viewers delayed by visibility LOD, stay in list until all viewers receive changes
+    std::vector<Object*> delayed;
+    uint32 now = getMSTime();
+
     while(!i_objectsToClientUpdate.empty())
     {
         Object* obj = *i_objectsToClientUpdate.begin();
         i_objectsToClientUpdate.erase(i_objectsToClientUpdate.begin());
-        obj->BuildUpdateData(update_players);
+
+        if (!HasVisibilityLOD() || !obj->isType(TYPEMASK_WORLDOBJECT))
+        {
+            obj->BuildUpdateData(update_players);
+            continue;
+        }
+
+        WorldObject* wObj = (WorldObject*)obj;
+        if (wObj->IsLODUpdateDue(now))
+            wObj->BuildUpdateData(update_players);
+        else if (!wObj->HasLODDelayedViewers())
+            wObj->ClearUpdateMask(false);                   // changed values returned to sent state
+
+        if (wObj->HasLODDelayedViewers())
+            delayed.push_back(obj);
     }
 
+    i_objectsToClientUpdate.insert(delayed.begin(), delayed.end());
+
     WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
     for(UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
     {
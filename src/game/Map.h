@@ -33,7 +33,9 @@
 #include "GridMap.h"
 #include "GameSystem/GridRefManager.h"
 #include "MapRefManager.h"
+#include "PathFinder.h"
 #include "Utilities/TypeList.h"
+#include "Utilities/TimeQueue.h"
 
 #include <bitset>
 #include <list>
@@ -48,6 +50,12 @@ struct ScriptInfo;
 struct ScriptAction;
 class BattleGround;
 class GridMap;
+class UnitSpatialIndex;
+
+namespace MaNGOS
+{
+    struct ObjectUpdater;
+}
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -77,10 +85,19 @@ enum LevelRequirementVsMode
 #pragma pack(pop)
 #endif
 
+// client update rate tiers by distance between object and viewer camera, see Visibility.LOD.Maps
+enum VisibilityLODTier
+{
+    VISIBILITY_LOD_NEAR = 0,                                // full rate values and movement updates
+    VISIBILITY_LOD_MID  = 1,                                // values updates and movement heartbeats with Visibility.LOD.MidInterval rate
+    VISIBILITY_LOD_EDGE = 2,                                // values updates and movement heartbeats with Visibility.LOD.EdgeInterval rate
+};
+
 #define MAX_HEIGHT            100000.0f                     // can be use for find ground height at surface
 #define INVALID_HEIGHT       -100000.0f                     // for check, must be equal to VMAP_INVALID_HEIGHT, real value for unknown height is VMAP_INVALID_HEIGHT_VALUE
 #define MAX_FALL_DISTANCE     250000.0f                     // "unlimited fall" to find VMap ground if it is available, just larger than MAX_HEIGHT - INVALID_HEIGHT
 #define DEFAULT_HEIGHT_SEARCH     10.0f                     // default search distance to find height at nearby locations
+#define CROWD_REGION_CELLS    4                             // players density for crowd visibility counted in squares of cells
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
 
 class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::ObjectLevelLockable<Map, ACE_Thread_Mutex>
@@ -114,9 +131,19 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::Obj
         void MessageDistBroadcast(WorldObject *, WorldPacket *, float dist);
 
         float GetVisibilityDistance() const { return m_VisibleDistance; }
+        // visibility distance for objects seen from viewPoint, reduced in crowded regions (see Visibility.Crowd.*)
+        float GetVisibilityDistance(WorldObject const* viewPoint) const;
+        bool HasCrowdedRegions() const { return !m_crowdRegions.empty(); }
         //function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
 
+        bool HasVisibilityLOD() const { return m_lodNearDistance > 0.0f; }
+        float GetVisibilityLODDistance(VisibilityLODTier tier) const { return tier == VISIBILITY_LOD_NEAR ? m_lodNearDistance : m_lodMidDistance; }
+        VisibilityLODTier GetVisibilityLODTier(float dist) const
+        {
+            return dist <= m_lodNearDistance ? VISIBILITY_LOD_NEAR : (dist <= m_lodMidDistance ? VISIBILITY_LOD_MID : VISIBILITY_LOD_EDGE);
+        }
+
         void PlayerRelocation(Player *, float x, float y, float z, float angl);
         void CreatureRelocation(Creature *creature, float x, float y, float z, float orientation);
 
@@ -267,6 +294,22 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::Obj
         uint32 GenerateLocalLowGuid(HighGuid guidhigh);
         bool GetAreaInfo(float x, float y, float z, uint32 &mogpflags, int32 &adtId, int32 &rootId, int32 &groupId) const;
         bool IsOutdoors(float x, float y, float z) const;
+
+        // relocation notifiers (creature aggro, trade distance) collected at move and called once per tick in Map::Update
+        void ScheduleRelocationNotify(Unit* unit, bool force);
+
+        // visibility statistic: camera visibility updates and object visibility checks in them
+        void AddVisibilityChecks(uint32 checks) { ++m_visibilityUpdatesTick; m_visibilityChecksTick += checks; }
+        uint32 GetLastTickVisibilityUpdates() const { return m_lastVisibilityUpdates; }
+        uint32 GetLastTickVisibilityChecks() const { return m_lastVisibilityChecks; }
+        // creatures skipped in last Map::Update as dormant (see CreatureDormantOutOfSight)
+        uint32 GetLastTickDormantSkips() const { return m_lastDormantSkips; }
+
+        // dead creature respawn check at time (or later if respawn time changed), duplicate calls allowed
+        void ScheduleRespawn(Creature* creature, time_t respawnTime);
+
+        PathFinder& GetPathFinder() { return m_pathFinder; }
+        UnitSpatialIndex* GetUnitSpatialIndex() const { return m_unitIndex; }
     private:
         void LoadMapAndVMap(int gx, int gy);
         void LoadVMap(int gx, int gy);
@@ -280,7 +323,14 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::Obj
         void SendInitTransports( Player * player );
         void SendRemoveTransports( Player * player );
 
-        void PlayerRelocationNotify(Player* player, Cell cell, CellPair cellpair);
+        // update not yet updated in tick cells in radius around players
+        void UpdateCellsAroundPlayers(MaNGOS::ObjectUpdater& updater, float radius);
+        void ClassifyCellsInSight();
+
+        void ProcessRespawnQueue();
+
+        void PlayerRelocationNotify(Player* player, uint32 notifyPass);
+        void ProcessRelocationNotifies();
 
         bool CreatureCellRelocation(Creature *creature, Cell new_cell);
 
@@ -308,6 +358,11 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::Obj
         void ScriptsProcess();
 
         void SendObjectUpdates();
+
+        typedef UNORDERED_MAP<uint32, float> CrowdRegionMap;
+
+        static uint32 GetCrowdRegionKey(float x, float y);
+        void UpdateCrowdVisibility();
         std::set<Object *> i_objectsToClientUpdate;
     protected:
         void SetUnloadReferenceLock(const GridPair &p, bool on) { getNGrid(p.x_coord, p.y_coord)->setUnloadReferenceLock(on); }
@@ -340,9 +395,35 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::Obj
         GridMap *GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
 
+        // visibility of cells at dormant creatures update, see ClassifyCellsInSight
+        typedef UNORDERED_MAP<uint32, CellViewerRangeList> CellViewersMap;
+        std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> m_cellsInSight;
+        CellViewersMap m_cellViewers;                       // for cells not in m_cellsInSight
+
         std::set<WorldObject *> i_objectsToRemove;
         std::multimap<time_t, ScriptAction> m_scriptSchedule;
 
+        PathFinder m_pathFinder;
+        UnitSpatialIndex* m_unitIndex;                      // NULL if disabled
+
+        // creature guids by respawn time, entries validated at processing (creature can be unloaded or respawned already)
+        TimeQueue<ObjectGuid> m_respawnQueue;
+
+        std::vector<ObjectGuid> m_relocationNotifyQueue;
+        uint32 m_relocationNotifyPass;
+
+        uint32 m_visibilityUpdatesTick;                     // collected from end of previous Map::Update
+        uint32 m_visibilityChecksTick;
+        uint32 m_lastVisibilityUpdates;
+        uint32 m_lastVisibilityChecks;
+        uint32 m_lastDormantSkips;
+
+        float m_lodNearDistance;                            // 0 if visibility LOD disabled for map
+        float m_lodMidDistance;
+
+        CrowdRegionMap m_crowdRegions;                      // regions with changed from m_VisibleDistance visibility distance
+        uint32 m_crowdUpdateTimer;
+
         // Map local low guid counters
         ObjectGuidGenerator<HIGHGUID_DYNAMICOBJECT> m_DynObjectGuids;
         ObjectGuidGenerator<HIGHGUID_PET> m_PetGuids;
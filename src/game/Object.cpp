@@ -44,6 +44,7 @@
 #include "ObjectPosSelector.h"
 
 #include "TemporarySummon.h"
+#include "UnitSpatialIndex.h"
 
 uint32 GuidHigh2TypeId(uint32 guid_hi)
 {
@@ -214,7 +215,7 @@ void Object::SendCreateUpdateToPlayer(Player* player)
     player->GetSession()->SendPacket(&packet);
 }
 
-void Object::BuildValuesUpdateBlockForPlayer(UpdateData *data, Player *target) const
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData *data, Player *target, UpdateMask const* missedMask) const
 {
     ByteBuffer buf(500);
 
@@ -223,6 +224,8 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData *data, Player *target) c
 
     UpdateMask updateMask;
     updateMask.SetCount(m_valuesCount);
+    if (missedMask)
+        updateMask |= *missedMask;
 
     _SetUpdateBits(&updateMask, target);
     BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
@@ -1056,7 +1059,7 @@ bool Object::PrintIndexError(uint32 index, bool set) const
     return false;
 }
 
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players)
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, UpdateMask const* missedMask)
 {
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
@@ -1067,7 +1070,7 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, missedMask);
 }
 
 void Object::AddToClientUpdateList()
@@ -1090,6 +1093,7 @@ void Object::BuildUpdateData( UpdateDataMapType& /*update_players */)
 
 WorldObject::WorldObject()
     : m_isActiveObject(false), m_currMap(NULL), m_mapId(0), m_InstanceId(0), m_phaseMask(PHASEMASK_NORMAL),
+    m_lodMidUpdateTime(0), m_lodEdgeUpdateTime(0), m_lodMidHeartbeatTime(0), m_lodEdgeHeartbeatTime(0), m_lodChangeSerial(0),
     m_positionX(0.0f), m_positionY(0.0f), m_positionZ(0.0f), m_orientation(0.0f)
 {
 }
@@ -1113,7 +1117,13 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
     m_orientation = orientation;
 
     if(isType(TYPEMASK_UNIT))
+    {
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, orientation);
+
+        if (IsInWorld())
+            if (UnitSpatialIndex* index = GetMap()->GetUnitSpatialIndex())
+                index->Relocate((Unit*)this);
+    }
 }
 
 void WorldObject::Relocate(float x, float y, float z)
@@ -1123,7 +1133,13 @@ void WorldObject::Relocate(float x, float y, float z)
     m_positionZ = z;
 
     if(isType(TYPEMASK_UNIT))
+    {
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, GetOrientation());
+
+        if (IsInWorld())
+            if (UnitSpatialIndex* index = GetMap()->GetUnitSpatialIndex())
+                index->Relocate((Unit*)this);
+    }
 }
 
 uint32 WorldObject::GetZoneId() const
@@ -1588,11 +1604,43 @@ void WorldObject::SendMessageToSetExcept(WorldPacket *data, Player const* skippe
     //if object is in world, map for it already created!
     if (IsInWorld())
     {
-        MaNGOS::MessageDelivererExcept notifier(this, data, skipped_receiver);
+        // in crowded regions viewers see only part of objects in map visibility distance
+        MaNGOS::MessageDelivererExcept notifier(this, data, skipped_receiver, 0.0f, GetMap()->HasCrowdedRegions());
         Cell::VisitWorldObjects(this, notifier, GetMap()->GetVisibilityDistance());
     }
 }
 
+void WorldObject::SendMovementHeartbeatToSet(WorldPacket *data, Player const* skipped_receiver)
+{
+    if (!IsInWorld())
+        return;
+
+    Map* map = GetMap();
+    if (!map->HasVisibilityLOD())
+    {
+        SendMessageToSetExcept(data, skipped_receiver);
+        return;
+    }
+
+    // heartbeats only refresh already known position, far viewers receive them with lower rate
+    float dist = map->GetVisibilityLODDistance(VISIBILITY_LOD_NEAR);
+    uint32 now = getMSTime();
+    if (getMSTimeDiff(m_lodEdgeHeartbeatTime, now) >= sWorld.getConfig(CONFIG_UINT32_VISIBILITY_LOD_EDGE_INTERVAL))
+    {
+        dist = map->GetVisibilityDistance();
+        m_lodEdgeHeartbeatTime = now;
+        m_lodMidHeartbeatTime = now;
+    }
+    else if (getMSTimeDiff(m_lodMidHeartbeatTime, now) >= sWorld.getConfig(CONFIG_UINT32_VISIBILITY_LOD_MID_INTERVAL))
+    {
+        dist = map->GetVisibilityLODDistance(VISIBILITY_LOD_MID);
+        m_lodMidHeartbeatTime = now;
+    }
+
+    MaNGOS::MessageDelivererExcept notifier(this, data, skipped_receiver, dist, map->HasCrowdedRegions());
+    Cell::VisitWorldObjects(this, notifier, dist);
+}
+
 void WorldObject::SendObjectDeSpawnAnim(uint64 guid)
 {
     WorldPacket data(SMSG_GAMEOBJECT_DESPAWN_ANIM, 8);
@@ -1913,11 +1961,17 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType &i_updateDatas;
     WorldObject &i_object;
-    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj)
+    Map* i_map;
+    bool i_changed;                                         // object has values changes since last BuildUpdateData call
+    bool i_midDue;                                          // visibility LOD tiers that can receive values update now
+    bool i_edgeDue;
+    WorldObject::LODDelayedViewerMap i_delayedViewers;      // viewers skipped in this call
+    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d, bool changed, bool midDue, bool edgeDue)
+        : i_updateDatas(d), i_object(obj), i_map(obj.GetMap()), i_changed(changed), i_midDue(midDue), i_edgeDue(edgeDue)
     {
         // send self fields changes in another way, otherwise
         // with new camera system when player's camera too far from player, camera wouldn't receive packets and changes from player
-        if(i_object.isType(TYPEMASK_PLAYER))
+        if(i_changed && i_object.isType(TYPEMASK_PLAYER))
             i_object.BuildUpdateDataForPlayer((Player*)&i_object, i_updateDatas);
     }
 
@@ -1926,7 +1980,45 @@ struct WorldObjectChangeAccumulator
         for(CameraMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
         {
             Player* owner = iter->getSource()->GetOwner();
-            if(owner != &i_object && owner->HaveAtClient(&i_object))
+            if(owner == &i_object || !owner->HaveAtClient(&i_object))
+                continue;
+
+            if (!i_map->HasVisibilityLOD())
+            {
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                continue;
+            }
+
+            bool due;
+            switch (i_map->GetVisibilityLODTier(iter->getSource()->GetBody()->GetDistance(&i_object)))
+            {
+                case VISIBILITY_LOD_NEAR: due = true;      break;
+                case VISIBILITY_LOD_MID:  due = i_midDue;  break;
+                default:                  due = i_edgeDue; break;
+            }
+
+            WorldObject::LODDelayedViewerMap::const_iterator delayed = i_object.m_lodDelayedViewers.find(owner->GetObjectGuid());
+            bool delayedBefore = delayed != i_object.m_lodDelayedViewers.end();
+
+            if (!due)
+            {
+                // current changes have serial m_lodChangeSerial, not received by new delayed viewer
+                if (delayedBefore)
+                    i_delayedViewers.insert(*delayed);
+                else if (i_changed)
+                    i_delayedViewers[owner->GetObjectGuid()] = i_object.m_lodChangeSerial - 1;
+            }
+            else if (delayedBefore)
+            {
+                UpdateMask missedMask;
+                missedMask.SetCount(i_object.m_valuesCount);
+                for (uint16 index = 0; index < i_object.m_lodFieldSerials.size(); ++index)
+                    if (i_object.m_lodFieldSerials[index] > delayed->second)
+                        missedMask.SetBit(index);
+
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas, &missedMask);
+            }
+            else if (i_changed)
                 i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
         }
     }
@@ -1934,12 +2026,70 @@ struct WorldObjectChangeAccumulator
     template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
 };
 
+bool WorldObject::IsLODUpdateDue(uint32 now) const
+{
+    // object can be kept in client update list only for delayed viewers
+    for (uint16 index = 0; index < m_valuesCount; ++index)
+        if (m_uint32Values_mirror[index] != m_uint32Values[index])
+            return true;
+
+    return getMSTimeDiff(m_lodMidUpdateTime, now) >= sWorld.getConfig(CONFIG_UINT32_VISIBILITY_LOD_MID_INTERVAL) ||
+        getMSTimeDiff(m_lodEdgeUpdateTime, now) >= sWorld.getConfig(CONFIG_UINT32_VISIBILITY_LOD_EDGE_INTERVAL);
+}
+
 void WorldObject::BuildUpdateData( UpdateDataMapType & update_players)
 {
-    WorldObjectChangeAccumulator notifier(*this, update_players);
+    bool lod = GetMap()->HasVisibilityLOD();
+
+    // values updates to viewers in far visibility LOD tiers sent with lower rate,
+    // changed fields marked by change serial for build missed fields of each delayed viewer
+    bool changed = !lod;
+    for (uint16 index = 0; lod && index < m_valuesCount; ++index)
+    {
+        if (m_uint32Values_mirror[index] != m_uint32Values[index])
+        {
+            if (!changed)
+            {
+                changed = true;
+                ++m_lodChangeSerial;
+                if (m_lodFieldSerials.size() != m_valuesCount)
+                    m_lodFieldSerials.resize(m_valuesCount, 0);
+            }
+
+            m_lodFieldSerials[index] = m_lodChangeSerial;
+        }
+    }
+
+    uint32 now = getMSTime();
+    bool midDue = getMSTimeDiff(m_lodMidUpdateTime, now) >= sWorld.getConfig(CONFIG_UINT32_VISIBILITY_LOD_MID_INTERVAL);
+    bool edgeDue = getMSTimeDiff(m_lodEdgeUpdateTime, now) >= sWorld.getConfig(CONFIG_UINT32_VISIBILITY_LOD_EDGE_INTERVAL);
+
+    WorldObjectChangeAccumulator notifier(*this, update_players, changed, midDue, edgeDue);
     Cell::VisitWorldObjects(this, notifier, GetMap()->GetVisibilityDistance());
 
+    if (lod)
+    {
+        if (midDue)
+            m_lodMidUpdateTime = now;
+        if (edgeDue)
+            m_lodEdgeUpdateTime = now;
+
+        // viewers that left visibility range dropped, they get create block at return
+        m_lodDelayedViewers.swap(notifier.i_delayedViewers);
+
+        // all viewers up to date, serials can start again
+        if (m_lodDelayedViewers.empty() && m_lodChangeSerial)
+        {
+            m_lodChangeSerial = 0;
+            m_lodFieldSerials.clear();
+        }
+    }
+
     ClearUpdateMask(false);
+
+    // stay in map client update list until delayed viewers receive changes
+    if (!m_lodDelayedViewers.empty())
+        m_objectUpdated = true;
 }
 
 bool WorldObject::IsControlledByPlayer() const
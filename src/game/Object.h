@@ -23,10 +23,13 @@
 #include "ByteBuffer.h"
 #include "UpdateFields.h"
 #include "UpdateData.h"
+#include "UpdateMask.h"
 #include "ObjectGuid.h"
 #include "Camera.h"
 
 #include <set>
+#include <map>
+#include <vector>
 #include <string>
 
 #define CONTACT_DISTANCE            0.5f
@@ -136,7 +139,8 @@ class MANGOS_DLL_SPEC Object
         virtual void RemoveFromClientUpdateList();
         virtual void BuildUpdateData(UpdateDataMapType& update_players);
 
-        void BuildValuesUpdateBlockForPlayer( UpdateData *data, Player *target ) const;
+        // missedMask: fields changed earlier but not sent yet to target, see WorldObject::BuildUpdateData
+        void BuildValuesUpdateBlockForPlayer( UpdateData *data, Player *target, UpdateMask const* missedMask = NULL ) const;
         void BuildOutOfRangeUpdateBlock( UpdateData *data ) const;
         void BuildMovementUpdateBlock( UpdateData * data, uint16 flags = 0 ) const;
 
@@ -301,7 +305,7 @@ class MANGOS_DLL_SPEC Object
 
         void BuildMovementUpdate(ByteBuffer * data, uint16 updateFlags) const;
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer *data, UpdateMask *updateMask, Player *target ) const;
-        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players);
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, UpdateMask const* missedMask = NULL);
 
         uint16 m_objectType;
 
@@ -440,6 +444,7 @@ class MANGOS_DLL_SPEC WorldObject : public Object
         virtual void SendMessageToSet(WorldPacket *data, bool self);
         virtual void SendMessageToSetInRange(WorldPacket *data, float dist, bool self);
         void SendMessageToSetExcept(WorldPacket *data, Player const* skipped_receiver);
+        void SendMovementHeartbeatToSet(WorldPacket *data, Player const* skipped_receiver);
 
         void MonsterSay(const char* text, uint32 language, uint64 TargetGuid);
         void MonsterYell(const char* text, uint32 language, uint64 TargetGuid);
@@ -489,6 +494,10 @@ class MANGOS_DLL_SPEC WorldObject : public Object
 
         bool isActiveObject() const { return m_isActiveObject || m_viewPoint.hasViewers(); }
 
+        // visibility LOD maps: values changes not sent yet to viewers in mid or edge tier
+        bool HasLODDelayedViewers() const { return !m_lodDelayedViewers.empty(); }
+        bool IsLODUpdateDue(uint32 now) const;
+
         ViewPoint& GetViewPoint() { return m_viewPoint; }
     protected:
         explicit WorldObject();
@@ -509,6 +518,17 @@ class MANGOS_DLL_SPEC WorldObject : public Object
         uint32 m_InstanceId;                                // in map copy with instance id
         uint32 m_phaseMask;                                 // in area phase state
 
+        uint32 m_lodMidUpdateTime;                          // last values update send time to mid visibility LOD tier
+        uint32 m_lodEdgeUpdateTime;                         // last values update send time to edge visibility LOD tier
+        uint32 m_lodMidHeartbeatTime;                       // last movement heartbeat send time to mid visibility LOD tier
+        uint32 m_lodEdgeHeartbeatTime;                      // last movement heartbeat send time to edge visibility LOD tier
+        // viewers skipped by visibility LOD, each with last change serial it received,
+        // so viewer of every tier get only fields changed after own last values update
+        typedef std::map<ObjectGuid, uint32> LODDelayedViewerMap;
+        LODDelayedViewerMap m_lodDelayedViewers;
+        uint32 m_lodChangeSerial;                           // serial of last values change, reset when no delayed viewers
+        std::vector<uint32> m_lodFieldSerials;              // change serial of each field
+
         float m_positionX;
         float m_positionY;
         float m_positionZ;
@@ -92,13 +92,16 @@ ObjectAccessor::FindPlayer(ObjectGuid guid)
 Player*
 ObjectAccessor::FindPlayerByName(const char *name)
 {
-    HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for(HashMapHolder<Player>::MapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if(iter->second->IsInWorld() && ( ::strcmp(name, iter->second->GetName()) == 0 ))
-            return iter->second;
+    // name index lookup, exact name match as before
+    ObjectGuid guid = sObjectMgr.GetPlayerGUIDByName(name);
+    if (guid.IsEmpty())
+        return NULL;
 
-    return NULL;
+    Player* plr = FindPlayer(guid);
+    if (!plr || ::strcmp(name, plr->GetName()) != 0)
+        return NULL;
+
+    return plr;
 }
 
 void
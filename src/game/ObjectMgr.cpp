@@ -47,6 +47,8 @@
 #include "GossipDef.h"
 #include "Mail.h"
 #include "InstanceData.h"
+#include "QueryResponseCache.h"
+#include "AuctionHouseMgr.h"
 
 #include <limits>
 
@@ -274,6 +276,7 @@ CreatureInfo const* ObjectMgr::GetCreatureTemplate(uint32 id)
 void ObjectMgr::LoadCreatureLocales()
 {
     mCreatureLocaleMap.clear();                              // need for reload case
+    sQueryResponseCache.Clear(QUERY_CACHE_CREATURE);
 
     QueryResult *result = WorldDatabase.Query("SELECT entry,name_loc1,subname_loc1,name_loc2,subname_loc2,name_loc3,subname_loc3,name_loc4,subname_loc4,name_loc5,subname_loc5,name_loc6,subname_loc6,name_loc7,subname_loc7,name_loc8,subname_loc8 FROM locales_creature");
 
@@ -1639,103 +1642,202 @@ void ObjectMgr::LoadGameobjectRespawnTimes()
     sLog.outString();
 }
 
-// name must be checked to correctness (if received) before call this function
-uint64 ObjectMgr::GetPlayerGUIDByName(std::string name) const
+void ObjectMgr::LoadCharacterNameData()
 {
-    uint64 guid = 0;
+    mCharacterNameData.clear();
+    mCharacterNameIndex.clear();
+    mCharacterDeclinedNames.clear();
 
-    CharacterDatabase.escape_string(name);
+    //                                                    0     1     2        3     4      5       6
+    QueryResult *result = CharacterDatabase.Query("SELECT guid, name, account, race, class, gender, level FROM characters WHERE deleteDate IS NULL");
+    if (!result)
+    {
+        barGoLink bar(1);
+        bar.step();
 
-    // Player name safe to sending to DB (checked at login) and this function using
-    QueryResult *result = CharacterDatabase.PQuery("SELECT guid FROM characters WHERE name = '%s'", name.c_str());
-    if(result)
+        sLog.outString();
+        sLog.outString(">> Loaded 0 character names");
+        return;
+    }
+
+    barGoLink bar((int)result->GetRowCount());
+
+    do
     {
-        guid = ObjectGuid(HIGHGUID_PLAYER, (*result)[0].GetUInt32()).GetRawValue();
+        Field* fields = result->Fetch();
+        bar.step();
 
-        delete result;
+        AddCharacterNameData(ObjectGuid(HIGHGUID_PLAYER, fields[0].GetUInt32()), fields[1].GetCppString(), fields[2].GetUInt32(),
+            fields[3].GetUInt8(), fields[4].GetUInt8(), fields[5].GetUInt8(), fields[6].GetUInt8());
+    } while (result->NextRow());
+
+    delete result;
+
+    // declined names used only in name query responses
+    if (sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED))
+    {
+        //                                        0     1         2       3           4             5
+        result = CharacterDatabase.Query("SELECT guid, genitive, dative, accusative, instrumental, prepositional FROM character_declinedname");
+        if (result)
+        {
+            do
+            {
+                Field* fields = result->Fetch();
+
+                // if the first declined name field is empty, the rest must be too
+                if (fields[1].GetCppString().empty())
+                    continue;
+
+                DeclinedName& names = mCharacterDeclinedNames[fields[0].GetUInt32()];
+                for (int i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
+                    names.name[i] = fields[i + 1].GetCppString();
+            } while (result->NextRow());
+
+            delete result;
+        }
     }
 
-    return guid;
+    sLog.outString();
+    sLog.outString(">> Loaded %u character names, %u declined names", uint32(mCharacterNameData.size()), uint32(mCharacterDeclinedNames.size()));
 }
 
-bool ObjectMgr::GetPlayerNameByGUID(ObjectGuid guid, std::string &name) const
+CharacterNameData const* ObjectMgr::GetCharacterNameData(ObjectGuid guid) const
+{
+    CharacterNameDataMap::const_iterator itr = mCharacterNameData.find(guid.GetCounter());
+    return itr != mCharacterNameData.end() ? &itr->second : NULL;
+}
+
+DeclinedName const* ObjectMgr::GetCharacterDeclinedNames(ObjectGuid guid) const
 {
-    // prevent DB access for online player
-    if(Player* player = GetPlayer(guid))
+    CharacterDeclinedNameMap::const_iterator itr = mCharacterDeclinedNames.find(guid.GetCounter());
+    return itr != mCharacterDeclinedNames.end() ? &itr->second : NULL;
+}
+
+void ObjectMgr::AddCharacterNameData(ObjectGuid guid, std::string const& name, uint32 account, uint8 race, uint8 playerClass, uint8 gender, uint8 level)
+{
+    CharacterNameData& data = mCharacterNameData[guid.GetCounter()];
+    data.name = name;
+    data.account = account;
+    data.race = race;
+    data.playerClass = playerClass;
+    data.gender = gender;
+    data.level = level;
+
+    // name can be not unique for characters with rename at login flag (loaded from player dump), first kept in index
+    std::string key = name;
+    if (normalizePlayerName(key))
+        mCharacterNameIndex.insert(CharacterNameIndexMap::value_type(key, guid.GetCounter()));
+}
+
+void ObjectMgr::DeleteCharacterNameData(ObjectGuid guid)
+{
+    CharacterNameDataMap::iterator itr = mCharacterNameData.find(guid.GetCounter());
+    if (itr == mCharacterNameData.end())
+        return;
+
+    std::string key = itr->second.name;
+    if (normalizePlayerName(key))
     {
-        name = player->GetName();
-        return true;
+        CharacterNameIndexMap::iterator idxItr = mCharacterNameIndex.find(key);
+        if (idxItr != mCharacterNameIndex.end() && idxItr->second == guid.GetCounter())
+            mCharacterNameIndex.erase(idxItr);
     }
 
-    uint32 lowguid = guid.GetCounter();
+    mCharacterNameData.erase(itr);
+    mCharacterDeclinedNames.erase(guid.GetCounter());
+}
 
-    QueryResult *result = CharacterDatabase.PQuery("SELECT name FROM characters WHERE guid = '%u'", lowguid);
+void ObjectMgr::UpdateCharacterName(ObjectGuid guid, std::string const& name)
+{
+    CharacterNameDataMap::iterator itr = mCharacterNameData.find(guid.GetCounter());
+    if (itr == mCharacterNameData.end())
+        return;
 
-    if(result)
+    std::string key = itr->second.name;
+    if (normalizePlayerName(key))
     {
-        name = (*result)[0].GetCppString();
-        delete result;
-        return true;
+        CharacterNameIndexMap::iterator idxItr = mCharacterNameIndex.find(key);
+        if (idxItr != mCharacterNameIndex.end() && idxItr->second == guid.GetCounter())
+            mCharacterNameIndex.erase(idxItr);
     }
 
-    return false;
+    itr->second.name = name;
+
+    key = name;
+    if (normalizePlayerName(key))
+        mCharacterNameIndex[key] = guid.GetCounter();
+
+    // declined names removed from DB at any name change
+    mCharacterDeclinedNames.erase(guid.GetCounter());
 }
 
-uint32 ObjectMgr::GetPlayerTeamByGUID(ObjectGuid guid) const
+void ObjectMgr::UpdateCharacterGender(ObjectGuid guid, uint8 gender)
+{
+    CharacterNameDataMap::iterator itr = mCharacterNameData.find(guid.GetCounter());
+    if (itr != mCharacterNameData.end())
+        itr->second.gender = gender;
+}
+
+void ObjectMgr::UpdateCharacterLevel(ObjectGuid guid, uint8 level)
+{
+    CharacterNameDataMap::iterator itr = mCharacterNameData.find(guid.GetCounter());
+    if (itr != mCharacterNameData.end())
+        itr->second.level = level;
+}
+
+void ObjectMgr::UpdateCharacterDeclinedNames(ObjectGuid guid, DeclinedName const& names)
 {
-    // prevent DB access for online player
-    if (Player* player = GetPlayer(guid))
-        return Player::TeamForRace(player->getRace());
+    if (!sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED))
+        return;
 
-    uint32 lowguid = guid.GetCounter();
+    mCharacterDeclinedNames[guid.GetCounter()] = names;
+}
 
-    QueryResult *result = CharacterDatabase.PQuery("SELECT race FROM characters WHERE guid = '%u'", lowguid);
+// name must be checked to correctness (if received) before call this function
+uint64 ObjectMgr::GetPlayerGUIDByName(std::string name) const
+{
+    if (!normalizePlayerName(name))
+        return 0;
 
-    if (result)
-    {
-        uint8 race = (*result)[0].GetUInt8();
-        delete result;
-        return Player::TeamForRace(race);
-    }
+    CharacterNameIndexMap::const_iterator itr = mCharacterNameIndex.find(name);
+    if (itr == mCharacterNameIndex.end())
+        return 0;
 
-    return 0;
+    return ObjectGuid(HIGHGUID_PLAYER, itr->second).GetRawValue();
 }
 
-uint32 ObjectMgr::GetPlayerAccountIdByGUID(ObjectGuid guid) const
+bool ObjectMgr::GetPlayerNameByGUID(ObjectGuid guid, std::string &name) const
 {
-    // prevent DB access for online player
-    if(Player* player = GetPlayer(guid))
-        return player->GetSession()->GetAccountId();
+    CharacterNameData const* data = GetCharacterNameData(guid);
+    if (!data)
+        return false;
 
-    uint32 lowguid = guid.GetCounter();
+    name = data->name;
+    return true;
+}
 
-    QueryResult *result = CharacterDatabase.PQuery("SELECT account FROM characters WHERE guid = '%u'", lowguid);
-    if (result)
-    {
-        uint32 acc = (*result)[0].GetUInt32();
-        delete result;
-        return acc;
-    }
+uint32 ObjectMgr::GetPlayerTeamByGUID(ObjectGuid guid) const
+{
+    CharacterNameData const* data = GetCharacterNameData(guid);
+    return data ? Player::TeamForRace(data->race) : 0;
+}
 
-    return 0;
+uint32 ObjectMgr::GetPlayerAccountIdByGUID(ObjectGuid guid) const
+{
+    CharacterNameData const* data = GetCharacterNameData(guid);
+    return data ? data->account : 0;
 }
 
 uint32 ObjectMgr::GetPlayerAccountIdByPlayerName(const std::string& name) const
 {
-    QueryResult *result = CharacterDatabase.PQuery("SELECT account FROM characters WHERE name = '%s'", name.c_str());
-    if(result)
-    {
-        uint32 acc = (*result)[0].GetUInt32();
-        delete result;
-        return acc;
-    }
-
-    return 0;
+    return GetPlayerAccountIdByGUID(GetPlayerGUIDByName(name));
 }
 
 void ObjectMgr::LoadItemLocales()
 {
     mItemLocaleMap.clear();                                 // need for reload case
+    sQueryResponseCache.Clear(QUERY_CACHE_ITEM);
+    sAuctionMgr.ClearSearchNames();
 
     QueryResult *result = WorldDatabase.Query("SELECT entry,name_loc1,description_loc1,name_loc2,description_loc2,name_loc3,description_loc3,name_loc4,description_loc4,name_loc5,description_loc5,name_loc6,description_loc6,name_loc7,description_loc7,name_loc8,description_loc8 FROM locales_item");
 
@@ -3553,6 +3655,7 @@ void ObjectMgr::LoadQuests()
     for(QuestMap::const_iterator itr=mQuestTemplates.begin(); itr != mQuestTemplates.end(); ++itr)
         delete itr->second;
     mQuestTemplates.clear();
+    sQueryResponseCache.Clear(QUERY_CACHE_QUEST);
 
     mExclusiveQuestGroups.clear();
 
@@ -4230,6 +4333,7 @@ void ObjectMgr::LoadQuests()
 void ObjectMgr::LoadQuestLocales()
 {
     mQuestLocaleMap.clear();                                // need for reload case
+    sQueryResponseCache.Clear(QUERY_CACHE_QUEST);
 
     QueryResult *result = WorldDatabase.Query("SELECT entry,"
         "Title_loc1,Details_loc1,Objectives_loc1,OfferRewardText_loc1,RequestItemsText_loc1,EndText_loc1,CompletedText_loc1,ObjectiveText1_loc1,ObjectiveText2_loc1,ObjectiveText3_loc1,ObjectiveText4_loc1,"
@@ -4824,6 +4928,7 @@ void ObjectMgr::LoadCreatureMovementScripts()
 void ObjectMgr::LoadPageTexts()
 {
     sPageTextStore.Free();                                  // for reload case
+    sQueryResponseCache.Clear(QUERY_CACHE_PAGE_TEXT);
 
     sPageTextStore.Load();
     sLog.outString( ">> Loaded %u page texts", sPageTextStore.RecordCount );
@@ -4868,6 +4973,7 @@ void ObjectMgr::LoadPageTexts()
 void ObjectMgr::LoadPageTextLocales()
 {
     mPageTextLocaleMap.clear();                             // need for reload case
+    sQueryResponseCache.Clear(QUERY_CACHE_PAGE_TEXT);
 
     QueryResult *result = WorldDatabase.Query("SELECT entry,text_loc1,text_loc2,text_loc3,text_loc4,text_loc5,text_loc6,text_loc7,text_loc8 FROM locales_page_text");
 
@@ -4988,6 +5094,8 @@ GossipText const *ObjectMgr::GetGossipText(uint32 Text_ID) const
 
 void ObjectMgr::LoadGossipText()
 {
+    sQueryResponseCache.Clear(QUERY_CACHE_NPC_TEXT);        // need for reload case
+
     QueryResult *result = WorldDatabase.Query( "SELECT * FROM npc_text" );
 
     int count = 0;
@@ -5047,6 +5155,7 @@ void ObjectMgr::LoadGossipText()
 void ObjectMgr::LoadNpcTextLocales()
 {
     mNpcTextLocaleMap.clear();                              // need for reload case
+    sQueryResponseCache.Clear(QUERY_CACHE_NPC_TEXT);
 
     QueryResult *result = WorldDatabase.Query("SELECT entry,"
         "Text0_0_loc1,Text0_1_loc1,Text1_0_loc1,Text1_1_loc1,Text2_0_loc1,Text2_1_loc1,Text3_0_loc1,Text3_1_loc1,Text4_0_loc1,Text4_1_loc1,Text5_0_loc1,Text5_1_loc1,Text6_0_loc1,Text6_1_loc1,Text7_0_loc1,Text7_1_loc1,"
@@ -5119,16 +5228,58 @@ void ObjectMgr::LoadNpcTextLocales()
     sLog.outString( ">> Loaded %lu NpcText locale strings", (unsigned long)mNpcTextLocaleMap.size() );
 }
 
+#define MAIL_EXPIRE_BATCH_SIZE  500                         // max expired mails changed in one transaction
+
+// delete expired mails (and items of mails from list) by one statement for list, caller start transaction
+// mails still checked by expire time: scan result can be stale at async processing (mail returned or re-sent already)
+static void DeleteExpiredMails(std::vector<uint32>& itemMailIds, std::vector<uint32>& mailIds, time_t basetime)
+{
+    std::ostringstream expired;
+    expired << ") AND expire_time < '" << uint64(basetime) << "'";
+
+    if (!itemMailIds.empty())
+    {
+        // only items still attached to mail, item can be taken already by receiver
+        CharacterDatabase.ExecuteIdList("DELETE FROM item_instance WHERE guid IN (SELECT item_guid FROM mail_items WHERE mail_id IN (SELECT id FROM mail WHERE id IN (",
+            itemMailIds, (expired.str() + "))").c_str(), MAIL_EXPIRE_BATCH_SIZE);
+        itemMailIds.clear();
+    }
+
+    if (!mailIds.empty())
+    {
+        CharacterDatabase.ExecuteIdList("DELETE FROM mail WHERE id IN (", mailIds, expired.str().c_str(), MAIL_EXPIRE_BATCH_SIZE);
+        mailIds.clear();
+    }
+}
+
 //not very fast function but it is called only once a day, or on starting-up
 void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
 {
     time_t basetime = time(NULL);
     DEBUG_LOG("Returning mails current time: hour: %d, minute: %d, second: %d ", localtime(&basetime)->tm_hour, localtime(&basetime)->tm_min, localtime(&basetime)->tm_sec);
+
+    //                                0  1           2      3        4         5           6   7       8
+    char const* query = "SELECT id,messageType,sender,receiver,has_items,expire_time,cod,checked,mailTemplateId FROM mail WHERE expire_time < '" UI64FMTD "'";
+
+    // at server work scan result processed later in world thread, not block world update while query executed
+    if (serverUp)
+    {
+        CharacterDatabase.AsyncPQuery(this, &ObjectMgr::ReturnOrDeleteOldMailsCallback, uint64(basetime), query, (uint64)basetime);
+        return;
+    }
+
     //delete all old mails without item and without body immediately, if starting server
-    if (!serverUp)
-        CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND body = ''", (uint64)basetime);
-    //                                                     0  1           2      3        4         5           6   7       8
-    QueryResult* result = CharacterDatabase.PQuery("SELECT id,messageType,sender,receiver,has_items,expire_time,cod,checked,mailTemplateId FROM mail WHERE expire_time < '" UI64FMTD "'", (uint64)basetime);
+    CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND body = ''", (uint64)basetime);
+    ProcessOldMails(CharacterDatabase.PQuery(query, (uint64)basetime), basetime, false);
+}
+
+void ObjectMgr::ReturnOrDeleteOldMailsCallback(QueryResult* result, uint64 basetime)
+{
+    ProcessOldMails(result, time_t(basetime), true);
+}
+
+void ObjectMgr::ProcessOldMails(QueryResult* result, time_t basetime, bool serverUp)
+{
     if ( !result )
     {
         barGoLink bar(1);
@@ -5138,84 +5289,64 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
         return;                                             // any mails need to be returned or deleted
     }
 
-    //std::ostringstream delitems, delmails; //will be here for optimization
-    //bool deletemail = false, deleteitem = false;
-    //delitems << "DELETE FROM item_instance WHERE guid IN ( ";
-    //delmails << "DELETE FROM mail WHERE id IN ( "
-
     barGoLink bar( (int)result->GetRowCount() );
     uint32 count = 0;
+    uint32 batchCount = 0;
     Field *fields;
 
+    std::vector<uint32> itemMailIds;                        // mails for delete with items
+    std::vector<uint32> mailIds;                            // all mails for delete
+
+    // changes committed by transaction per MAIL_EXPIRE_BATCH_SIZE mails
+    CharacterDatabase.BeginTransaction();
+
     do
     {
         bar.step();
 
         fields = result->Fetch();
-        Mail *m = new Mail;
-        m->messageID = fields[0].GetUInt32();
-        m->messageType = fields[1].GetUInt8();
-        m->sender = fields[2].GetUInt32();
-        m->receiver = fields[3].GetUInt32();
+        uint32 messageID = fields[0].GetUInt32();
+        uint8 messageType = fields[1].GetUInt8();
+        uint32 sender = fields[2].GetUInt32();
+        uint32 receiver = fields[3].GetUInt32();
         bool has_items = fields[4].GetBool();
-        m->expire_time = (time_t)fields[5].GetUInt64();
-        m->deliver_time = 0;
-        m->COD = fields[6].GetUInt32();
-        m->checked = fields[7].GetUInt32();
-        m->mailTemplateId = fields[8].GetInt16();
-
-        Player *pl = 0;
-        if (serverUp)
-            pl = GetPlayer((uint64)m->receiver);
-        if (pl)
-        {                                                   //this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
-            //his in mailbox and he has already listed his mails )
-            delete m;
+        uint32 checked = fields[7].GetUInt32();
+
+        //this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
+        //his in mailbox and he has already listed his mails )
+        if (serverUp && GetPlayer(ObjectGuid(HIGHGUID_PLAYER, receiver)))
             continue;
-        }
+
         //delete or return mail:
-        if (has_items)
+        //if it is mail from AH, it shouldn't be returned, but deleted
+        if (has_items && messageType == MAIL_NORMAL && !(checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
         {
-            QueryResult *resultItems = CharacterDatabase.PQuery("SELECT item_guid,item_template FROM mail_items WHERE mail_id='%u'", m->messageID);
-            if(resultItems)
-            {
-                do
-                {
-                    Field *fields2 = resultItems->Fetch();
-
-                    uint32 item_guid_low = fields2[0].GetUInt32();
-                    uint32 item_template = fields2[1].GetUInt32();
-
-                    m->AddItem(item_guid_low, item_template);
-                }
-                while (resultItems->NextRow());
+            //mail will be returned:
+            CharacterDatabase.PExecute("UPDATE mail SET sender = '%u', receiver = '%u', expire_time = '" UI64FMTD "', deliver_time = '" UI64FMTD "',cod = '0', checked = '%u' WHERE id = '%u' AND expire_time < '" UI64FMTD "'", receiver, sender, (uint64)(basetime + 30*DAY), (uint64)basetime, MAIL_CHECK_MASK_RETURNED, messageID, (uint64)basetime);
+        }
+        else
+        {
+            // mail open and then not returned
+            if (has_items)
+                itemMailIds.push_back(messageID);
 
-                delete resultItems;
-            }
-            //if it is mail from AH, it shouldn't be returned, but deleted
-            if (m->messageType != MAIL_NORMAL || m->messageType == MAIL_AUCTION || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
-            {
-                // mail open and then not returned
-                for(std::vector<MailItemInfo>::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
-                    CharacterDatabase.PExecute("DELETE FROM item_instance WHERE guid = '%u'", itr2->item_guid);
-            }
-            else
-            {
-                //mail will be returned:
-                CharacterDatabase.PExecute("UPDATE mail SET sender = '%u', receiver = '%u', expire_time = '" UI64FMTD "', deliver_time = '" UI64FMTD "',cod = '0', checked = '%u' WHERE id = '%u'", m->receiver, m->sender, (uint64)(basetime + 30*DAY), (uint64)basetime, MAIL_CHECK_MASK_RETURNED, m->messageID);
-                delete m;
-                continue;
-            }
+            mailIds.push_back(messageID);
+            ++count;
         }
 
-        //deletemail = true;
-        //delmails << m->messageID << ", ";
-        CharacterDatabase.PExecute("DELETE FROM mail WHERE id = '%u'", m->messageID);
-        delete m;
-        ++count;
+        if (++batchCount >= MAIL_EXPIRE_BATCH_SIZE)
+        {
+            DeleteExpiredMails(itemMailIds, mailIds, basetime);
+            CharacterDatabase.CommitTransaction();
+            CharacterDatabase.BeginTransaction();
+            batchCount = 0;
+        }
     } while (result->NextRow());
     delete result;
 
+    DeleteExpiredMails(itemMailIds, mailIds, basetime);
+    CharacterDatabase.CommitTransaction();
+
     sLog.outString();
     sLog.outString( ">> Loaded %u mails", count );
 }
@@ -6116,6 +6247,7 @@ uint32 ObjectMgr::GenerateLowGuid(HighGuid guidhigh)
 void ObjectMgr::LoadGameObjectLocales()
 {
     mGameObjectLocaleMap.clear();                           // need for reload case
+    sQueryResponseCache.Clear(QUERY_CACHE_GAMEOBJECT);
 
     QueryResult *result = WorldDatabase.Query("SELECT entry,"
         "name_loc1,name_loc2,name_loc3,name_loc4,name_loc5,name_loc6,name_loc7,name_loc8,"
@@ -7157,9 +7289,7 @@ void ObjectMgr::LoadWeatherZoneChances()
 void ObjectMgr::SaveCreatureRespawnTime(uint32 loguid, uint32 instance, time_t t)
 {
     mCreatureRespawnTimes[MAKE_PAIR64(loguid,instance)] = t;
-    WorldDatabase.PExecute("DELETE FROM creature_respawn WHERE guid = '%u' AND instance = '%u'", loguid, instance);
-    if(t)
-        WorldDatabase.PExecute("INSERT INTO creature_respawn VALUES ( '%u', '" UI64FMTD "', '%u' )", loguid, uint64(t), instance);
+    mPendingCreatureRespawnTimes[MAKE_PAIR64(loguid,instance)] = t;
 }
 
 void ObjectMgr::DeleteCreatureData(uint32 guid)
@@ -7175,35 +7305,59 @@ void ObjectMgr::DeleteCreatureData(uint32 guid)
 void ObjectMgr::SaveGORespawnTime(uint32 loguid, uint32 instance, time_t t)
 {
     mGORespawnTimes[MAKE_PAIR64(loguid,instance)] = t;
-    WorldDatabase.PExecute("DELETE FROM gameobject_respawn WHERE guid = '%u' AND instance = '%u'", loguid, instance);
-    if(t)
-        WorldDatabase.PExecute("INSERT INTO gameobject_respawn VALUES ( '%u', '" UI64FMTD "', '%u' )", loguid, uint64(t), instance);
+    mPendingGORespawnTimes[MAKE_PAIR64(loguid,instance)] = t;
 }
 
 void ObjectMgr::DeleteRespawnTimeForInstance(uint32 instance)
 {
-    RespawnTimes::iterator next;
+    RespawnTimes* respawnTimes[] = { &mGORespawnTimes, &mCreatureRespawnTimes, &mPendingGORespawnTimes, &mPendingCreatureRespawnTimes };
+
+    for(int i = 0; i < 4; ++i)
+    {
+        for(RespawnTimes::iterator itr = respawnTimes[i]->begin(); itr != respawnTimes[i]->end();)
+        {
+            if(PAIR64_HIPART(itr->first) == instance)
+                respawnTimes[i]->erase(itr++);
+            else
+                ++itr;
+        }
+    }
+
+    WorldDatabase.PExecute("DELETE FROM creature_respawn WHERE instance = '%u'", instance);
+    WorldDatabase.PExecute("DELETE FROM gameobject_respawn WHERE instance = '%u'", instance);
+}
+
+void ObjectMgr::SavePendingRespawnTimes()
+{
+    if (mPendingCreatureRespawnTimes.empty() && mPendingGORespawnTimes.empty())
+        return;
+
+    WorldDatabase.BeginTransaction();
 
-    for(RespawnTimes::iterator itr = mGORespawnTimes.begin(); itr != mGORespawnTimes.end(); itr = next)
+    for(RespawnTimes::const_iterator itr = mPendingCreatureRespawnTimes.begin(); itr != mPendingCreatureRespawnTimes.end(); ++itr)
     {
-        next = itr;
-        ++next;
+        uint32 loguid = PAIR64_LOPART(itr->first);
+        uint32 instance = PAIR64_HIPART(itr->first);
 
-        if(GUID_HIPART(itr->first)==instance)
-            mGORespawnTimes.erase(itr);
+        WorldDatabase.PExecute("DELETE FROM creature_respawn WHERE guid = '%u' AND instance = '%u'", loguid, instance);
+        if(itr->second)
+            WorldDatabase.PExecute("INSERT INTO creature_respawn VALUES ( '%u', '" UI64FMTD "', '%u' )", loguid, uint64(itr->second), instance);
     }
 
-    for(RespawnTimes::iterator itr = mCreatureRespawnTimes.begin(); itr != mCreatureRespawnTimes.end(); itr = next)
+    for(RespawnTimes::const_iterator itr = mPendingGORespawnTimes.begin(); itr != mPendingGORespawnTimes.end(); ++itr)
     {
-        next = itr;
-        ++next;
+        uint32 loguid = PAIR64_LOPART(itr->first);
+        uint32 instance = PAIR64_HIPART(itr->first);
 
-        if(GUID_HIPART(itr->first)==instance)
-            mCreatureRespawnTimes.erase(itr);
+        WorldDatabase.PExecute("DELETE FROM gameobject_respawn WHERE guid = '%u' AND instance = '%u'", loguid, instance);
+        if(itr->second)
+            WorldDatabase.PExecute("INSERT INTO gameobject_respawn VALUES ( '%u', '" UI64FMTD "', '%u' )", loguid, uint64(itr->second), instance);
     }
 
-    WorldDatabase.PExecute("DELETE FROM creature_respawn WHERE instance = '%u'", instance);
-    WorldDatabase.PExecute("DELETE FROM gameobject_respawn WHERE instance = '%u'", instance);
+    WorldDatabase.CommitTransaction();
+
+    mPendingCreatureRespawnTimes.clear();
+    mPendingGORespawnTimes.clear();
 }
 
 void ObjectMgr::DeleteGOData(uint32 guid)
@@ -425,6 +425,21 @@ SkillRangeType GetSkillRangeType(SkillLineEntry const *pSkill, bool racial);
 
 bool normalizePlayerName(std::string& name);
 
+// Static character data, kept in memory for all existing characters (online or not)
+struct CharacterNameData
+{
+    std::string name;
+    uint32 account;
+    uint8 race;
+    uint8 playerClass;
+    uint8 gender;
+    uint8 level;
+};
+
+typedef UNORDERED_MAP<uint32/*lowguid*/, CharacterNameData> CharacterNameDataMap;
+typedef UNORDERED_MAP<std::string/*normalized name*/, uint32/*lowguid*/> CharacterNameIndexMap;
+typedef UNORDERED_MAP<uint32/*lowguid*/, DeclinedName> CharacterDeclinedNameMap;
+
 struct MANGOS_DLL_SPEC LanguageDesc
 {
     Language lang_id;
@@ -558,6 +573,16 @@ class ObjectMgr
         }
         void GetPlayerLevelInfo(uint32 race, uint32 class_,uint32 level, PlayerLevelInfo* info) const;
 
+        void LoadCharacterNameData();
+        CharacterNameData const* GetCharacterNameData(ObjectGuid guid) const;
+        DeclinedName const* GetCharacterDeclinedNames(ObjectGuid guid) const;
+        void AddCharacterNameData(ObjectGuid guid, std::string const& name, uint32 account, uint8 race, uint8 playerClass, uint8 gender, uint8 level);
+        void DeleteCharacterNameData(ObjectGuid guid);
+        void UpdateCharacterName(ObjectGuid guid, std::string const& name);
+        void UpdateCharacterGender(ObjectGuid guid, uint8 gender);
+        void UpdateCharacterLevel(ObjectGuid guid, uint8 level);
+        void UpdateCharacterDeclinedNames(ObjectGuid guid, DeclinedName const& names);
+
         uint64 GetPlayerGUIDByName(std::string name) const;
         bool GetPlayerNameByGUID(ObjectGuid guid, std::string &name) const;
         uint32 GetPlayerTeamByGUID(ObjectGuid guid) const;
@@ -918,6 +943,8 @@ class ObjectMgr
         time_t GetGORespawnTime(uint32 loguid, uint32 instance) { return mGORespawnTimes[MAKE_PAIR64(loguid,instance)]; }
         void SaveGORespawnTime(uint32 loguid, uint32 instance, time_t t);
         void DeleteRespawnTimeForInstance(uint32 instance);
+        // respawn times changed after previous call written in one transaction (see SaveRespawnTimeInterval)
+        void SavePendingRespawnTimes();
 
         // grid objects
         void AddCreatureToGrid(uint32 guid, CreatureData const* data);
@@ -1045,6 +1072,10 @@ class ObjectMgr
 
         typedef std::multimap<uint32, CreatureModelRace> CreatureModelRaceMap;
 
+        CharacterNameDataMap     mCharacterNameData;
+        CharacterNameIndexMap    mCharacterNameIndex;
+        CharacterDeclinedNameMap mCharacterDeclinedNames;
+
         GroupMap            mGroupMap;
         GuildMap            mGuildMap;
         ArenaTeamMap        mArenaTeamMap;
@@ -1090,6 +1121,9 @@ class ObjectMgr
         int DBCLocaleIndex;
 
     private:
+        void ReturnOrDeleteOldMailsCallback(QueryResult* result, uint64 basetime);
+        void ProcessOldMails(QueryResult* result, time_t basetime, bool serverUp);
+
         void LoadScripts(ScriptMapMap& scripts, char const* tablename);
         void CheckScriptTexts(ScriptMapMap const& scripts,std::set<int32>& ids);
         void LoadCreatureAddons(SQLStorage& creatureaddons, char const* entryName, char const* comment);
@@ -1134,6 +1168,8 @@ class ObjectMgr
         PointOfInterestLocaleMap mPointOfInterestLocaleMap;
         RespawnTimes mCreatureRespawnTimes;
         RespawnTimes mGORespawnTimes;
+        RespawnTimes mPendingCreatureRespawnTimes;          // not saved to DB yet, 0 for delete
+        RespawnTimes mPendingGORespawnTimes;
 
         // Storage for Conditions. First element (index 0) is reserved for zero-condition (nothing required)
         typedef std::vector<PlayerCondition> ConditionStore;
@@ -36,6 +36,7 @@ class Path
         void resize(unsigned int sz) { i_nodes.resize(sz); }
         void clear() { i_nodes.clear(); }
         void erase(uint32 idx) { i_nodes.erase(i_nodes.begin()+idx); }
+        void push_back(PathElem const& elem) { i_nodes.push_back(elem); }
 
         float GetTotalLength(uint32 start, uint32 end) const
         {
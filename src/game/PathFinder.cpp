@@ -0,0 +1,399 @@
+/*
+ * Copyright (C) 2005-2010 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "PathFinder.h"
+#include "Map.h"
+#include "VMapFactory.h"
+#include "Log.h"
+#include "World.h"
+
+#include <queue>
+
+#define PATHFINDER_SMOOTH_LOOKAHEAD   16                    // max nodes skipped by one smoothed segment
+#define PATHFINDER_CACHE_CLEANUP      (5*IN_MILLISECONDS)
+#define PATHFINDER_DIAGONAL_STEP      (PATHFINDER_STEP_SIZE*1.41421356f)
+
+namespace
+{
+    struct SearchNode
+    {
+        SearchNode(int32 _lx, int32 _ly, float _z, float _g, float _f, int32 _parent)
+            : lx(_lx), ly(_ly), z(_z), g(_g), f(_f), parent(_parent), closed(false) {}
+
+        int32 lx, ly;
+        float z;
+        float g;                                            // walked distance from start
+        float f;                                            // g + estimated distance to goal
+        int32 parent;
+        bool closed;
+    };
+
+    // lattice coordinates fit in 16 bits: MAP_HALFSIZE / PATHFINDER_STEP_SIZE < 0x8000
+    inline uint32 MakeLatticeKey(int32 lx, int32 ly)
+    {
+        return (uint32(uint16(lx + 0x8000)) << 16) | uint32(uint16(ly + 0x8000));
+    }
+
+    inline uint32 MakeHeightTileKey(int32 lx, int32 ly)
+    {
+        return ((uint32(lx + 0x8000) / PATHFINDER_HEIGHT_TILE_SIZE) << 16) | (uint32(ly + 0x8000) / PATHFINDER_HEIGHT_TILE_SIZE);
+    }
+
+    typedef std::pair<float, uint32> OpenEntry;
+    typedef std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry> > OpenQueue;
+
+    int32 const neighbourDX[8] = { 1, -1, 0,  0, 1,  1, -1, -1 };
+    int32 const neighbourDY[8] = { 0,  0, 1, -1, 1, -1,  1, -1 };
+}
+
+PathFinder::PathFinder(Map const* map) : m_map(map), m_heightCacheSize(0), m_time(0), m_tickNodes(0), m_lastTickNodes(0),
+    m_cacheHits(0), m_cacheMisses(0), m_budgetFallbacks(0)
+{
+}
+
+void PathFinder::ClearCache()
+{
+    m_cache.clear();
+    m_cacheOrder.clear();
+    m_heightCache.clear();
+    m_heightTileOrder.clear();
+    m_heightCacheSize = 0;
+}
+
+void PathFinder::Update(uint32 diff)
+{
+    m_lastTickNodes = m_tickNodes;
+    m_tickNodes = 0;
+
+    uint32 prevTime = m_time;
+    m_time += diff;
+
+    if (prevTime / PATHFINDER_CACHE_CLEANUP == m_time / PATHFINDER_CACHE_CLEANUP)
+        return;
+
+    // expire time set at last use, so expired paths are at begin of use order
+    while (!m_cacheOrder.empty())
+    {
+        PathCache::iterator itr = m_cache.find(m_cacheOrder.front());
+        if (itr->second.expireTime > m_time)
+            break;
+
+        m_cache.erase(itr);
+        m_cacheOrder.pop_front();
+    }
+}
+
+bool PathFinder::BuildPath(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, SimplePath& path)
+{
+    SimplePathNode src  = { srcX, srcY, srcZ };
+    SimplePathNode dest = { destX, destY, destZ };
+
+    path.clear();
+    path.push_back(src);
+
+    float dx = destX - srcX;
+    float dy = destY - srcY;
+
+    // too short for lattice search, direct movement expected
+    if (dx*dx + dy*dy < PATHFINDER_MIN_DISTANCE*PATHFINDER_MIN_DISTANCE)
+    {
+        path.push_back(dest);
+        return true;
+    }
+
+    PathCacheKey key;
+    key.nodes = (uint64(MakeLatticeKey(ToLattice(srcX), ToLattice(srcY))) << 32) | MakeLatticeKey(ToLattice(destX), ToLattice(destY));
+    key.levels = (uint32(uint16(ToLevel(srcZ))) << 16) | uint32(uint16(ToLevel(destZ)));
+
+    PathCache::iterator itr = m_cache.find(key);
+    if (itr != m_cache.end())
+    {
+        ++m_cacheHits;
+        itr->second.expireTime = m_time + PATHFINDER_CACHE_EXPIRE;
+        m_cacheOrder.splice(m_cacheOrder.end(), m_cacheOrder, itr->second.orderItr);
+    }
+    else
+    {
+        uint32 maxTickNodes = sWorld.getConfig(CONFIG_UINT32_PATHFINDING_MAX_NODES_PER_TICK);
+        if (m_tickNodes >= maxTickNodes)
+        {
+            ++m_budgetFallbacks;
+            path.push_back(dest);
+            return false;
+        }
+
+        ++m_cacheMisses;
+
+        std::vector<SimplePathNode> nodes;
+        SearchResult result = SEARCH_FOUND;
+        if (!IsWalkableSegment(src, dest))
+        {
+            uint32 searched = 0;
+            result = FindPath(src, dest, std::min(uint32(PATHFINDER_MAX_NODES), maxTickNodes - m_tickNodes), nodes, searched);
+            m_tickNodes += searched;
+        }
+
+        // not completed search repeated at next query
+        if (result == SEARCH_BUDGET_REACHED)
+        {
+            ++m_budgetFallbacks;
+            path.push_back(dest);
+            return false;
+        }
+
+        // cache size hard limit, expired entries normally removed in Update
+        if (m_cache.size() >= PATHFINDER_CACHE_MAX_SIZE)
+        {
+            m_cache.erase(m_cacheOrder.front());
+            m_cacheOrder.pop_front();
+        }
+
+        CachedPath& cached = m_cache[key];
+        cached.expireTime = m_time + PATHFINDER_CACHE_EXPIRE;
+        cached.orderItr = m_cacheOrder.insert(m_cacheOrder.end(), key);
+        cached.found = result == SEARCH_FOUND;
+
+        if (!nodes.empty())
+        {
+            SmoothPath(nodes);
+            // store only intermediate points, end points replaced by real ones at use
+            if (nodes.size() > 2)
+                cached.nodes.assign(nodes.begin() + 1, nodes.end() - 1);
+        }
+
+        itr = m_cache.find(key);
+    }
+
+    for (std::vector<SimplePathNode>::const_iterator nItr = itr->second.nodes.begin(); nItr != itr->second.nodes.end(); ++nItr)
+        path.push_back(*nItr);
+    path.push_back(dest);
+
+    return itr->second.found;
+}
+
+PathFinder::SearchResult PathFinder::FindPath(SimplePathNode const& src, SimplePathNode const& dest, uint32 maxNodes,
+    std::vector<SimplePathNode>& nodes, uint32& searched) const
+{
+    int32 const destLX = ToLattice(dest.x);
+    int32 const destLY = ToLattice(dest.y);
+
+    std::vector<SearchNode> searchNodes;
+    searchNodes.reserve(maxNodes);
+
+    UNORDERED_MAP<uint32, uint32> nodeIndex;
+    OpenQueue open;
+
+    float h = sqrt((dest.x - src.x)*(dest.x - src.x) + (dest.y - src.y)*(dest.y - src.y));
+    searchNodes.push_back(SearchNode(ToLattice(src.x), ToLattice(src.y), src.z, 0.0f, h, -1));
+    nodeIndex[MakeLatticeKey(searchNodes[0].lx, searchNodes[0].ly)] = 0;
+    open.push(OpenEntry(h, 0));
+
+    int32 goal = -1;
+
+    while (!open.empty())
+    {
+        uint32 curIdx = open.top().second;
+        open.pop();
+
+        if (searchNodes[curIdx].closed)
+            continue;
+
+        searchNodes[curIdx].closed = true;
+
+        if (searchNodes[curIdx].lx == destLX && searchNodes[curIdx].ly == destLY)
+        {
+            goal = int32(curIdx);
+            break;
+        }
+
+        // copy, searchNodes can be reallocated at push_back
+        SearchNode const cur = searchNodes[curIdx];
+
+        for (int i = 0; i < 8; ++i)
+        {
+            int32 lx = cur.lx + neighbourDX[i];
+            int32 ly = cur.ly + neighbourDY[i];
+            uint32 lkey = MakeLatticeKey(lx, ly);
+
+            UNORDERED_MAP<uint32, uint32>::const_iterator idxItr = nodeIndex.find(lkey);
+            if (idxItr != nodeIndex.end() && searchNodes[idxItr->second].closed)
+                continue;
+
+            float stepDist = (i < 4) ? PATHFINDER_STEP_SIZE : PATHFINDER_DIAGONAL_STEP;
+
+            float z;
+            if (!GetNodeHeight(lx, ly, cur.z, z) || fabs(z - cur.z) > stepDist * PATHFINDER_MAX_SLOPE)
+                continue;
+
+            float g = cur.g + stepDist;
+
+            if (idxItr != nodeIndex.end())
+            {
+                SearchNode& known = searchNodes[idxItr->second];
+                if (g >= known.g)
+                    continue;
+
+                known.f -= known.g - g;
+                known.g = g;
+                known.z = z;
+                known.parent = int32(curIdx);
+                open.push(OpenEntry(known.f, idxItr->second));
+                continue;
+            }
+
+            if (searchNodes.size() >= maxNodes)
+                continue;
+
+            float x = FromLattice(lx);
+            float y = FromLattice(ly);
+            float f = g + sqrt((dest.x - x)*(dest.x - x) + (dest.y - y)*(dest.y - y));
+            uint32 newIdx = searchNodes.size();
+            searchNodes.push_back(SearchNode(lx, ly, z, g, f, int32(curIdx)));
+            nodeIndex[lkey] = newIdx;
+            open.push(OpenEntry(f, newIdx));
+        }
+    }
+
+    searched = searchNodes.size();
+
+    if (goal < 0)
+    {
+        if (searched >= maxNodes && maxNodes < PATHFINDER_MAX_NODES)
+            return SEARCH_BUDGET_REACHED;
+
+        DEBUG_LOG("PathFinder: no path found in map %u from (%f,%f,%f) to (%f,%f,%f), searched %u nodes",
+            m_map->GetId(), src.x, src.y, src.z, dest.x, dest.y, dest.z, searched);
+        return SEARCH_NOT_FOUND;
+    }
+
+    // collect in reverse order, real end points instead lattice centers
+    nodes.clear();
+    nodes.push_back(dest);
+    for (int32 idx = searchNodes[goal].parent; idx > 0; idx = searchNodes[idx].parent)
+    {
+        SimplePathNode node = { FromLattice(searchNodes[idx].lx), FromLattice(searchNodes[idx].ly), searchNodes[idx].z };
+        nodes.push_back(node);
+    }
+    nodes.push_back(src);
+
+    std::reverse(nodes.begin(), nodes.end());
+    return SEARCH_FOUND;
+}
+
+void PathFinder::SmoothPath(std::vector<SimplePathNode>& nodes) const
+{
+    if (nodes.size() <= 2)
+        return;
+
+    std::vector<SimplePathNode> smoothed;
+    smoothed.push_back(nodes[0]);
+
+    size_t cur = 0;
+    while (cur + 1 < nodes.size())
+    {
+        size_t next = std::min(nodes.size() - 1, cur + PATHFINDER_SMOOTH_LOOKAHEAD);
+        while (next > cur + 1 && !IsWalkableSegment(nodes[cur], nodes[next]))
+            --next;
+
+        smoothed.push_back(nodes[next]);
+        cur = next;
+    }
+
+    nodes.swap(smoothed);
+}
+
+bool PathFinder::IsWalkableSegment(SimplePathNode const& from, SimplePathNode const& to) const
+{
+    float dx = to.x - from.x;
+    float dy = to.y - from.y;
+    float dist = sqrt(dx*dx + dy*dy);
+
+    uint32 steps = uint32(ceil(dist / PATHFINDER_STEP_SIZE));
+    if (steps == 0)
+        return true;
+
+    float stepDist = dist / steps;
+    float z = from.z;
+    for (uint32 i = 1; i < steps; ++i)
+    {
+        float nz;
+        if (!GetSurfaceHeight(from.x + dx * i / steps, from.y + dy * i / steps, z, nz) || fabs(nz - z) > stepDist * PATHFINDER_MAX_SLOPE)
+            return false;
+
+        z = nz;
+    }
+
+    if (fabs(to.z - z) > stepDist * PATHFINDER_MAX_SLOPE)
+        return false;
+
+    VMAP::IVMapManager* vMapManager = VMAP::VMapFactory::createOrGetVMapManager();
+    return vMapManager->isInLineOfSight(m_map->GetId(), from.x, from.y, from.z + 2.0f, to.x, to.y, to.z + 2.0f);
+}
+
+bool PathFinder::GetSurfaceHeight(float x, float y, float refZ, float& z) const
+{
+    // search from max climb height above reference point, so next floor of building not selected
+    float const climb = PATHFINDER_DIAGONAL_STEP * PATHFINDER_MAX_SLOPE;
+    z = m_map->GetHeight(x, y, refZ + climb, true, 2 * climb);
+    return z > INVALID_HEIGHT;
+}
+
+bool PathFinder::GetNodeHeight(int32 lx, int32 ly, float refZ, float& z) const
+{
+    // terrain static, so height for node and reference height range can be reused by any later search
+    int32 zStep = int32(floor(refZ / PATHFINDER_HEIGHT_CACHE_Z_STEP));
+    uint64 key = (uint64(MakeLatticeKey(lx, ly)) << 32) | uint32(zStep);
+    uint32 tileKey = MakeHeightTileKey(lx, ly);
+
+    HeightCache::iterator tileItr = m_heightCache.find(tileKey);
+    if (tileItr != m_heightCache.end())
+    {
+        m_heightTileOrder.splice(m_heightTileOrder.end(), m_heightTileOrder, tileItr->second.orderItr);
+
+        UNORDERED_MAP<uint64, float>::const_iterator itr = tileItr->second.heights.find(key);
+        if (itr != tileItr->second.heights.end())
+        {
+            z = itr->second;
+            return z > INVALID_HEIGHT;
+        }
+    }
+
+    bool found = GetSurfaceHeight(FromLattice(lx), FromLattice(ly), (float(zStep) + 0.5f) * PATHFINDER_HEIGHT_CACHE_Z_STEP, z);
+
+    // drop least recently used tiles only, so searches in other areas keep their heights
+    while (m_heightCacheSize >= PATHFINDER_HEIGHT_CACHE_MAX_SIZE && m_heightTileOrder.front() != tileKey)
+    {
+        HeightCache::iterator oldItr = m_heightCache.find(m_heightTileOrder.front());
+        m_heightCacheSize -= oldItr->second.heights.size();
+        m_heightCache.erase(oldItr);
+        m_heightTileOrder.pop_front();
+    }
+
+    tileItr = m_heightCache.find(tileKey);
+    if (tileItr == m_heightCache.end())
+    {
+        HeightTile& tile = m_heightCache[tileKey];
+        tile.orderItr = m_heightTileOrder.insert(m_heightTileOrder.end(), tileKey);
+        tile.heights[key] = found ? z : INVALID_HEIGHT;
+    }
+    else
+        tileItr->second.heights[key] = found ? z : INVALID_HEIGHT;
+
+    ++m_heightCacheSize;
+    return found;
+}
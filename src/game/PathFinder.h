@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2005-2010 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PATHFINDER_H
+#define MANGOS_PATHFINDER_H
+
+#include "Common.h"
+#include "Path.h"
+#include "Utilities/UnorderedMapSet.h"
+
+#include <list>
+
+class Map;
+
+#define PATHFINDER_STEP_SIZE          4.0f                  // lattice step, close to .map height grid resolution
+#define PATHFINDER_MAX_SLOPE          1.2f                  // max dz per horizontal yard (~50 degrees)
+#define PATHFINDER_MAX_NODES          1024                  // search limit, direct movement used if reached (also limited by PathFinding.MaxNodesPerTick)
+#define PATHFINDER_MIN_DISTANCE       (2*PATHFINDER_STEP_SIZE)
+#define PATHFINDER_CACHE_EXPIRE       (30*IN_MILLISECONDS)
+#define PATHFINDER_CACHE_MAX_SIZE     2048
+#define PATHFINDER_CACHE_Z_STEP       4.0f                  // height precision of cached path end points, less than floors distance in buildings
+#define PATHFINDER_HEIGHT_CACHE_MAX_SIZE (64*1024)
+#define PATHFINDER_HEIGHT_CACHE_Z_STEP 2.0f                 // reference height precision of cached lattice node heights
+#define PATHFINDER_HEIGHT_TILE_SIZE   16                    // lattice nodes per side of height cache tile, least recently used tiles dropped at overflow
+
+// start/end lattice nodes and height levels of cached path, so paths at different floors/bridge levels not mixed
+struct PathCacheKey
+{
+    uint64 nodes;
+    uint32 levels;
+
+    bool operator== (PathCacheKey const& key) const { return nodes == key.nodes && levels == key.levels; }
+    bool operator< (PathCacheKey const& key) const { return nodes < key.nodes || (nodes == key.nodes && levels < key.levels); }
+    uint64 GetHashValue() const { return nodes ^ (uint64(levels) * UI64LIT(0x9E3779B97F4A7C15)); }
+};
+
+HASH_NAMESPACE_START
+
+    template<>
+    class hash<PathCacheKey>
+    {
+        public:
+
+            size_t operator() (PathCacheKey const& key) const
+            {
+                return hash<uint64>()(key.GetHashValue());
+            }
+    };
+
+    // for pre-TR1 Visual Studio versions (VS90 SP1 or early)
+    inline size_t hash_value(PathCacheKey const& key)
+    {
+        return hash_value(key.GetHashValue());
+    }
+
+HASH_NAMESPACE_END
+
+/**
+ * Per-map path query service.
+ *
+ * Used for point, home, chase and follow movement (see PathFinding.Enable, disabled by default).
+ * Chase and follow build new path only when target leaves lattice node or height level of current
+ * path end point, smaller target moves only change path end point (see DestinationHolder::SetDestination).
+ *
+ * Paths are searched (A*) over a lattice of PATHFINDER_STEP_SIZE placed on the terrain
+ * by Map::GetHeight, so already loaded .map grids (and vmaps if height calculation enabled)
+ * are the source of walkable surface data, no offline generated navigation data used.
+ * Found paths are smoothed by dropping nodes reachable by a direct walkable segment and
+ * cached by start/end lattice node pair and their height levels, least recently used paths
+ * dropped at cache overflow. Lattice node surface heights are cached too (by tiles of lattice
+ * nodes, least recently used tiles dropped at overflow), so repeated searches over same area
+ * not repeat height probes.
+ *
+ * Searched nodes count per map update limited by PathFinding.MaxNodesPerTick, queries
+ * over the limit get direct path (not cached), so mass evade does not spike map update time.
+ */
+class MANGOS_DLL_SPEC PathFinder
+{
+    public:
+        explicit PathFinder(Map const* map);
+
+        // fill path with points from src to dest (include both), return false if only direct path available
+        bool BuildPath(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, SimplePath& path);
+
+        void Update(uint32 diff);
+        void ClearCache();
+
+        // points in same lattice node and height level, path to one point usable for other
+        static bool IsSameNode(float x1, float y1, float z1, float x2, float y2, float z2)
+        {
+            return ToLattice(x1) == ToLattice(x2) && ToLattice(y1) == ToLattice(y2) && ToLevel(z1) == ToLevel(z2);
+        }
+
+        uint32 GetCacheSize() const { return m_cache.size(); }
+        uint32 GetHeightCacheSize() const { return m_heightCacheSize; }
+        uint32 GetCacheHits() const { return m_cacheHits; }
+        uint32 GetCacheMisses() const { return m_cacheMisses; }
+        uint32 GetBudgetFallbacks() const { return m_budgetFallbacks; }
+        uint32 GetLastTickNodes() const { return m_lastTickNodes; }
+
+    private:
+        typedef std::list<PathCacheKey> CacheOrder;         // cache keys from least to most recently used
+        typedef std::list<uint32> HeightTileOrder;          // height tile keys from least to most recently used
+
+        struct CachedPath
+        {
+            std::vector<SimplePathNode> nodes;              // intermediate points only, empty for direct path
+            bool found;
+            uint32 expireTime;
+            CacheOrder::iterator orderItr;
+        };
+
+        struct HeightTile
+        {
+            UNORDERED_MAP<uint64, float> heights;           // INVALID_HEIGHT for nodes without surface
+            HeightTileOrder::iterator orderItr;
+        };
+
+        typedef UNORDERED_MAP<PathCacheKey, CachedPath> PathCache;
+        typedef UNORDERED_MAP<uint32, HeightTile> HeightCache;
+
+        enum SearchResult
+        {
+            SEARCH_FOUND,
+            SEARCH_NOT_FOUND,                               // all reachable nodes in PATHFINDER_MAX_NODES searched
+            SEARCH_BUDGET_REACHED,                          // search stopped by per tick nodes limit
+        };
+
+        SearchResult FindPath(SimplePathNode const& src, SimplePathNode const& dest, uint32 maxNodes, std::vector<SimplePathNode>& nodes, uint32& searched) const;
+        void SmoothPath(std::vector<SimplePathNode>& nodes) const;
+        bool IsWalkableSegment(SimplePathNode const& from, SimplePathNode const& to) const;
+        bool GetSurfaceHeight(float x, float y, float refZ, float& z) const;
+        bool GetNodeHeight(int32 lx, int32 ly, float refZ, float& z) const;
+
+        static int32 ToLattice(float c) { return int32(floor(c / PATHFINDER_STEP_SIZE)); }
+        static float FromLattice(int32 l) { return (float(l) + 0.5f) * PATHFINDER_STEP_SIZE; }
+        static int32 ToLevel(float z) { return int32(floor(z / PATHFINDER_CACHE_Z_STEP)); }
+
+        Map const* m_map;
+        PathCache m_cache;
+        CacheOrder m_cacheOrder;
+        mutable HeightCache m_heightCache;
+        mutable HeightTileOrder m_heightTileOrder;
+        mutable uint32 m_heightCacheSize;                   // heights count in all tiles
+        uint32 m_time;
+        uint32 m_tickNodes;                                 // searched nodes in current map update
+        uint32 m_lastTickNodes;
+        uint32 m_cacheHits;
+        uint32 m_cacheMisses;
+        uint32 m_budgetFallbacks;
+};
+
+#endif
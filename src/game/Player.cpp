@@ -2603,6 +2603,7 @@ void Player::GiveLevel(uint32 level)
     _ApplyAllLevelScaleItemMods(false);
 
     SetLevel(level);
+    sObjectMgr.UpdateCharacterLevel(GetObjectGuid(), level);
 
     UpdateSkillsForLevel ();
 
@@ -4331,11 +4332,14 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
             CharacterDatabase.PExecute("DELETE FROM guild_eventlog WHERE PlayerGuid1 = '%u' OR PlayerGuid2 = '%u'", lowguid, lowguid);
             CharacterDatabase.PExecute("DELETE FROM guild_bank_eventlog WHERE PlayerGuid = '%u'", lowguid);
             CharacterDatabase.CommitTransaction();
+
+            sObjectMgr.DeleteCharacterNameData(playerguid);
             break;
         }
         // The character gets unlinked from the account, the name gets freed up and appears as deleted ingame
         case 1:
             CharacterDatabase.PExecute("UPDATE characters SET deleteInfos_Name=name, deleteInfos_Account=account, deleteDate='" UI64FMTD "', name='', account=0 WHERE guid=%u", uint64(time(NULL)), lowguid);
+            sObjectMgr.DeleteCharacterNameData(playerguid);
             break;
         default:
             sLog.outError("Player::DeleteFromDB: Unsupported delete method: %u.", charDelete_method);
@@ -6945,7 +6949,10 @@ void Player::_ApplyItemMods(Item *item, uint8 slot,bool apply)
     if(attacktype < MAX_ATTACK)
         _ApplyWeaponDependentAuraMods(item,WeaponAttackType(attacktype),apply);
 
+    // item stats, armor, resistances and weapon damage recalculated once
+    BeginStatUpdateBatch();
     _ApplyItemBonuses(proto,slot,apply);
+    EndStatUpdateBatch();
 
     if( slot==EQUIPMENT_SLOT_RANGED )
         _ApplyAmmoBonuses();
@@ -7715,6 +7722,8 @@ void Player::_ApplyAllItemMods()
 
 void Player::_ApplyAllLevelScaleItemMods(bool apply)
 {
+    BeginStatUpdateBatch();
+
     for (int i = 0; i < INVENTORY_SLOT_BAG_END; ++i)
     {
         if(m_items[i])
@@ -7729,6 +7738,8 @@ void Player::_ApplyAllLevelScaleItemMods(bool apply)
             _ApplyItemBonuses(proto,i, apply, true);
         }
     }
+
+    EndStatUpdateBatch();
 }
 
 void Player::_ApplyAmmoBonuses()
@@ -18181,7 +18192,7 @@ void Player::HandleStealthedUnitsDetection()
             {
                 ObjectGuid i_guid = (*i)->GetGUID();
                 (*i)->SendCreateUpdateToPlayer(this);
-                m_clientGUIDs.insert(i_guid);
+                AddClientGUID(i_guid);
 
                 DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "%s is detected in stealth by player %u. Distance = %f",i_guid.GetString().c_str(),GetGUIDLow(),GetDistance(*i));
 
@@ -19364,7 +19375,7 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, WorldObject* targe
         {
             target->SendCreateUpdateToPlayer(this);
             if(target->GetTypeId()!=TYPEID_GAMEOBJECT||!((GameObject*)target)->IsTransport())
-                m_clientGUIDs.insert(target->GetObjectGuid());
+                AddClientGUID(target->GetObjectGuid());
 
             DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "Object %u (Type: %u) is visible now for player %u. Distance = %f",target->GetGUIDLow(),target->GetTypeId(),GetGUIDLow(),GetDistance(target));
 
@@ -19380,16 +19391,16 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, WorldObject* targe
 }
 
 template<class T>
-inline void UpdateVisibilityOf_helper(ObjectGuidSet& s64, T* target)
+inline void UpdateVisibilityOf_helper(Player* player, T* target)
 {
-    s64.insert(target->GetGUID());
+    player->AddClientGUID(target->GetObjectGuid());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(ObjectGuidSet& s64, GameObject* target)
+inline void UpdateVisibilityOf_helper(Player* player, GameObject* target)
 {
     if(!target->IsTransport())
-        s64.insert(target->GetGUID());
+        player->AddClientGUID(target->GetObjectGuid());
 }
 
 template<class T>
@@ -19415,7 +19426,7 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, T* target, UpdateD
         {
             visibleNow.insert(target);
             target->BuildCreateUpdateBlockForPlayer(&data, this);
-            UpdateVisibilityOf_helper(m_clientGUIDs,target);
+            UpdateVisibilityOf_helper(this,target);
 
             DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "%s is visible now for %s. Distance = %f", target->GetObjectGuid().GetString().c_str(), GetObjectGuid().GetString().c_str(), GetDistance(target));
         }
@@ -20056,16 +20067,16 @@ void Player::UpdateForQuestWorldObjects()
 
     UpdateData udata;
     WorldPacket packet;
-    for(ObjectGuidSet::const_iterator itr=m_clientGUIDs.begin(); itr!=m_clientGUIDs.end(); ++itr)
+    for(ClientGUIDs::const_iterator itr=m_clientGUIDs.begin(); itr!=m_clientGUIDs.end(); ++itr)
     {
-        if (itr->IsGameobject())
+        if (itr->first.IsGameobject())
         {
-            if (GameObject *obj = GetMap()->GetGameObject(*itr))
+            if (GameObject *obj = GetMap()->GetGameObject(itr->first))
                 obj->BuildValuesUpdateBlockForPlayer(&udata,this);
         }
-        else if (itr->IsCreatureOrVehicle())
+        else if (itr->first.IsCreatureOrVehicle())
         {
-            Creature *obj = GetMap()->GetAnyTypeCreature(*itr);
+            Creature *obj = GetMap()->GetAnyTypeCreature(itr->first);
             if(!obj)
                 continue;
 
@@ -2278,10 +2278,12 @@ class MANGOS_DLL_SPEC Player : public Unit
 
         Object* GetObjectByTypeMask(ObjectGuid guid, TypeMask typemask);
 
-        // currently visible objects at player client
-        ObjectGuidSet m_clientGUIDs;
+        // currently visible objects at player client, value is stamp of last Camera visibility check that found object in range
+        typedef UNORDERED_MAP<ObjectGuid, uint32> ClientGUIDs;
+        ClientGUIDs m_clientGUIDs;
 
-        bool HaveAtClient(WorldObject const* u) { return u==this || m_clientGUIDs.find(u->GetGUID())!=m_clientGUIDs.end(); }
+        bool HaveAtClient(WorldObject const* u) { return u==this || m_clientGUIDs.find(u->GetObjectGuid())!=m_clientGUIDs.end(); }
+        void AddClientGUID(ObjectGuid guid) { m_clientGUIDs.insert(ClientGUIDs::value_type(guid, 0)); }
 
         bool IsVisibleInGridForPlayer(Player* pl) const;
         bool IsVisibleGloballyFor(Player* pl) const;
@@ -438,13 +438,10 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
 
     if (ObjectMgr::CheckPlayerName(name,true) == CHAR_NAME_SUCCESS)
     {
-        CharacterDatabase.escape_string(name);              // for safe, we use name only for sql quearies anyway
-        result = CharacterDatabase.PQuery("SELECT * FROM characters WHERE name = '%s'", name.c_str());
-        if (result)
-        {
+        if (sObjectMgr.GetPlayerGUIDByName(name))
             name = "";                                      // use the one from the dump
-            delete result;
-        }
+        else
+            CharacterDatabase.escape_string(name);          // for safe, we use name only for sql quearies anyway
     }
     else
         name = "";
@@ -456,6 +453,9 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
     snprintf(newpetid, 20, "%d", sObjectMgr.GeneratePetNumber());
     snprintf(lastpetid, 20, "%s", "");
 
+    std::string chrName;
+    uint8 chrRace = 0, chrClass = 0, chrGender = 0, chrLevel = 0;
+
     std::map<uint32,uint32> items;
     std::map<uint32,uint32> mails;
     std::map<uint32,uint32> eqsets;
@@ -552,13 +552,9 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
                 {
                     // check if the original name already exists
                     name = getnth(line, 3);                 // characters.name
-                    CharacterDatabase.escape_string(name);
 
-                    result = CharacterDatabase.PQuery("SELECT * FROM characters WHERE name = '%s'", name.c_str());
-                    if (result)
+                    if (sObjectMgr.GetPlayerGUIDByName(name))
                     {
-                        delete result;
-
                         if (!changenth(line, 36, "1"))      // characters.at_login set to "rename on login"
                             ROLLBACK(DUMP_FILE_BROKEN);
 
@@ -573,6 +569,12 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
                     nameInvalidated = true;
                 }
 
+                // data for character name cache, added at successful load
+                chrName = getnth(line, 3);                  // characters.name
+                chrRace = atoi(getnth(line, 4).c_str());    // characters.race
+                chrClass = atoi(getnth(line, 5).c_str());   // characters.class
+                chrGender = atoi(getnth(line, 6).c_str());  // characters.gender
+                chrLevel = atoi(getnth(line, 7).c_str());   // characters.level
                 break;
             }
             case DTT_INVENTORY:
@@ -711,6 +713,8 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
 
     CharacterDatabase.CommitTransaction();
 
+    sObjectMgr.AddCharacterNameData(ObjectGuid(HIGHGUID_PLAYER, guid), chrName, account, chrRace, chrClass, chrGender, chrLevel);
+
     //FIXME: current code with post-updating guids not safe for future per-map threads
     sObjectMgr.m_ItemGuids.Set(sObjectMgr.m_ItemGuids.GetNextAfterMaxUsed() + items.size());
     sObjectMgr.m_MailIds.Set(sObjectMgr.m_MailIds.GetNextAfterMaxUsed() +  mails.size());
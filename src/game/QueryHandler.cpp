@@ -26,6 +26,7 @@
 #include "Log.h"
 #include "World.h"
 #include "ObjectMgr.h"
+#include "QueryResponseCache.h"
 #include "ObjectGuid.h"
 #include "Player.h"
 #include "UpdateMask.h"
@@ -58,70 +59,44 @@ void WorldSession::SendNameQueryOpcode(Player *p)
     SendPacket(&data);
 }
 
-void WorldSession::SendNameQueryOpcodeFromDB(uint64 guid)
+void WorldSession::SendNameQueryOpcodeFromCache(ObjectGuid guid)
 {
-    CharacterDatabase.AsyncPQuery(&WorldSession::SendNameQueryOpcodeFromDBCallBack, GetAccountId(),
-        !sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED) ?
-    //   ------- Query Without Declined Names --------
-    //          0     1     2     3       4
-        "SELECT guid, name, race, gender, class "
-        "FROM characters WHERE guid = '%u'"
-        :
-    //   --------- Query With Declined Names ---------
-    //          0                1     2     3       4
-        "SELECT characters.guid, name, race, gender, class, "
-    //   5         6       7           8             9
-        "genitive, dative, accusative, instrumental, prepositional "
-        "FROM characters LEFT JOIN character_declinedname ON characters.guid = character_declinedname.guid WHERE characters.guid = '%u'",
-        GUID_LOPART(guid));
-}
+    CharacterNameData const* nameData = sObjectMgr.GetCharacterNameData(guid);
 
-void WorldSession::SendNameQueryOpcodeFromDBCallBack(QueryResult *result, uint32 accountId)
-{
-    if(!result)
-        return;
+                                                            // guess size
+    WorldPacket data( SMSG_NAME_QUERY_RESPONSE, (8+1+1+1+1+1+1+10) );
+    data << guid.WriteAsPacked();
+    data << uint8(0);                                       // added in 3.1; if > 1, then end of packet
 
-    WorldSession * session = sWorld.FindSession(accountId);
-    if(!session)
+    // deleted character (or not existed)
+    if (!nameData)
     {
-        delete result;
+        data << GetMangosString(LANG_NON_EXIST_CHARACTER);
+        data << uint8(0);                                   // realm name for cross realm BG usage
+        data << uint8(0);                                   // race
+        data << uint8(0);                                   // gender
+        data << uint8(0);                                   // class
+        data << uint8(0);                                   // is not declined
+        SendPacket( &data );
         return;
     }
 
-    Field *fields = result->Fetch();
-    uint32 lowguid      = fields[0].GetUInt32();
-    std::string name = fields[1].GetCppString();
-    uint8 pRace = 0, pGender = 0, pClass = 0;
-    if(name == "")
-        name         = session->GetMangosString(LANG_NON_EXIST_CHARACTER);
-    else
-    {
-        pRace        = fields[2].GetUInt8();
-        pGender      = fields[3].GetUInt8();
-        pClass       = fields[4].GetUInt8();
-    }
-                                                            // guess size
-    WorldPacket data( SMSG_NAME_QUERY_RESPONSE, (8+1+1+1+1+1+1+10) );
-    data << ObjectGuid(HIGHGUID_PLAYER, lowguid).WriteAsPacked();
-    data << uint8(0);                                       // added in 3.1; if > 1, then end of packet
-    data << name;
+    data << nameData->name;
     data << uint8(0);                                       // realm name for cross realm BG usage
-    data << uint8(pRace);                                   // race
-    data << uint8(pGender);                                 // gender
-    data << uint8(pClass);                                  // class
+    data << uint8(nameData->race);                          // race
+    data << uint8(nameData->gender);                        // gender
+    data << uint8(nameData->playerClass);                   // class
 
-    // if the first declined name field (5) is empty, the rest must be too
-    if(sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED) && fields[5].GetCppString() != "")
+    if (DeclinedName const* names = sObjectMgr.GetCharacterDeclinedNames(guid))
     {
         data << uint8(1);                                   // is declined
-        for(int i = 5; i < MAX_DECLINED_NAME_CASES+5; ++i)
-            data << fields[i].GetCppString();
+        for(int i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
+            data << names->name[i];
     }
     else
         data << uint8(0);                                   // is not declined
 
-    session->SendPacket( &data );
-    delete result;
+    SendPacket( &data );
 }
 
 void WorldSession::HandleNameQueryOpcode( WorldPacket & recv_data )
@@ -135,7 +110,7 @@ void WorldSession::HandleNameQueryOpcode( WorldPacket & recv_data )
     if (pChar)
         SendNameQueryOpcode(pChar);
     else
-        SendNameQueryOpcodeFromDB(guid);
+        SendNameQueryOpcodeFromCache(guid);
 }
 
 void WorldSession::HandleQueryTimeOpcode( WorldPacket & /*recv_data*/ )
@@ -154,11 +129,18 @@ void WorldSession::HandleCreatureQueryOpcode( WorldPacket & recv_data )
     CreatureInfo const *ci = ObjectMgr::GetCreatureTemplate(entry);
     if (ci)
     {
+        int loc_idx = GetSessionDbLocaleIndex();
+        if (WorldPacket const* cached = sQueryResponseCache.Find(QUERY_CACHE_CREATURE, entry, loc_idx))
+        {
+            SendPacket(cached);
+            DEBUG_LOG( "WORLD: Sent SMSG_CREATURE_QUERY_RESPONSE (cached)" );
+            return;
+        }
+
         std::string Name, SubName;
         Name = ci->Name;
         SubName = ci->SubName;
 
-        int loc_idx = GetSessionDbLocaleIndex();
         if (loc_idx >= 0)
         {
             CreatureLocale const *cl = sObjectMgr.GetCreatureLocale(entry);
@@ -172,7 +154,7 @@ void WorldSession::HandleCreatureQueryOpcode( WorldPacket & recv_data )
         }
         DETAIL_LOG("WORLD: CMSG_CREATURE_QUERY '%s' - Entry: %u.", ci->Name, entry);
                                                             // guess size
-        WorldPacket data( SMSG_CREATURE_QUERY_RESPONSE, 100 );
+        WorldPacket& data = sQueryResponseCache.Add(QUERY_CACHE_CREATURE, entry, loc_idx, SMSG_CREATURE_QUERY_RESPONSE, 100);
         data << uint32(entry);                              // creature entry
         data << Name;
         data << uint8(0) << uint8(0) << uint8(0);           // name2, name3, name4, always empty
@@ -219,6 +201,14 @@ void WorldSession::HandleGameObjectQueryOpcode( WorldPacket & recv_data )
     const GameObjectInfo *info = ObjectMgr::GetGameObjectInfo(entryID);
     if(info)
     {
+        int loc_idx = GetSessionDbLocaleIndex();
+        if (WorldPacket const* cached = sQueryResponseCache.Find(QUERY_CACHE_GAMEOBJECT, entryID, loc_idx))
+        {
+            SendPacket(cached);
+            DEBUG_LOG( "WORLD: Sent SMSG_GAMEOBJECT_QUERY_RESPONSE (cached)" );
+            return;
+        }
+
         std::string Name;
         std::string IconName;
         std::string CastBarCaption;
@@ -227,7 +217,6 @@ void WorldSession::HandleGameObjectQueryOpcode( WorldPacket & recv_data )
         IconName = info->IconName;
         CastBarCaption = info->castBarCaption;
 
-        int loc_idx = GetSessionDbLocaleIndex();
         if (loc_idx >= 0)
         {
             GameObjectLocale const *gl = sObjectMgr.GetGameObjectLocale(entryID);
@@ -240,7 +229,7 @@ void WorldSession::HandleGameObjectQueryOpcode( WorldPacket & recv_data )
             }
         }
         DETAIL_LOG("WORLD: CMSG_GAMEOBJECT_QUERY '%s' - Entry: %u. ", info->name, entryID);
-        WorldPacket data ( SMSG_GAMEOBJECT_QUERY_RESPONSE, 150 );
+        WorldPacket& data = sQueryResponseCache.Add(QUERY_CACHE_GAMEOBJECT, entryID, loc_idx, SMSG_GAMEOBJECT_QUERY_RESPONSE, 150);
         data << uint32(entryID);
         data << uint32(info->type);
         data << uint32(info->displayId);
@@ -331,7 +320,20 @@ void WorldSession::HandleNpcTextQueryOpcode( WorldPacket & recv_data )
 
     GossipText const* pGossip = sObjectMgr.GetGossipText(textID);
 
-    WorldPacket data( SMSG_NPC_TEXT_UPDATE, 100 );          // guess size
+    int loc_idx = GetSessionDbLocaleIndex();
+    if (pGossip)
+    {
+        if (WorldPacket const* cached = sQueryResponseCache.Find(QUERY_CACHE_NPC_TEXT, textID, loc_idx))
+        {
+            SendPacket(cached);
+            DEBUG_LOG( "WORLD: Sent SMSG_NPC_TEXT_UPDATE (cached)" );
+            return;
+        }
+    }
+
+    // response for not existed text not cached
+    WorldPacket missingData( SMSG_NPC_TEXT_UPDATE, 100 );   // guess size
+    WorldPacket& data = pGossip ? sQueryResponseCache.Add(QUERY_CACHE_NPC_TEXT, textID, loc_idx, SMSG_NPC_TEXT_UPDATE, 100) : missingData;
     data << textID;
 
     if (!pGossip)
@@ -359,7 +361,6 @@ void WorldSession::HandleNpcTextQueryOpcode( WorldPacket & recv_data )
             Text_1[i]=pGossip->Options[i].Text_1;
         }
 
-        int loc_idx = GetSessionDbLocaleIndex();
         if (loc_idx >= 0)
         {
             NpcTextLocale const *nl = sObjectMgr.GetNpcTextLocale(textID);
@@ -413,11 +414,26 @@ void WorldSession::HandlePageTextQueryOpcode( WorldPacket & recv_data )
     recv_data >> pageID;
     recv_data.read_skip<uint64>();                          // guid
 
+    int loc_idx = GetSessionDbLocaleIndex();
+
     while (pageID)
     {
         PageText const *pPage = sPageTextStore.LookupEntry<PageText>( pageID );
-                                                            // guess size
-        WorldPacket data( SMSG_PAGE_TEXT_QUERY_RESPONSE, 50 );
+
+        if (pPage)
+        {
+            if (WorldPacket const* cached = sQueryResponseCache.Find(QUERY_CACHE_PAGE_TEXT, pageID, loc_idx))
+            {
+                SendPacket(cached);
+                DEBUG_LOG( "WORLD: Sent SMSG_PAGE_TEXT_QUERY_RESPONSE (cached)" );
+                pageID = pPage->Next_Page;
+                continue;
+            }
+        }
+
+        // response for not existed page not cached
+        WorldPacket missingData( SMSG_PAGE_TEXT_QUERY_RESPONSE, 50 );
+        WorldPacket& data = pPage ? sQueryResponseCache.Add(QUERY_CACHE_PAGE_TEXT, pageID, loc_idx, SMSG_PAGE_TEXT_QUERY_RESPONSE, 50) : missingData;
         data << pageID;
 
         if (!pPage)
@@ -430,7 +446,6 @@ void WorldSession::HandlePageTextQueryOpcode( WorldPacket & recv_data )
         {
             std::string Text = pPage->Text;
 
-            int loc_idx = GetSessionDbLocaleIndex();
             if (loc_idx >= 0)
             {
                 PageTextLocale const *pl = sObjectMgr.GetPageTextLocale(pageID);
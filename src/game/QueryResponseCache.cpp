@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2005-2010 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "QueryResponseCache.h"
+#include "Policies/SingletonImp.h"
+
+INSTANTIATE_SINGLETON_1(QueryResponseCache);
+
+QueryResponseCache::QueryResponseCache()
+{
+    for (int i = 0; i < MAX_QUERY_CACHE_TYPE; ++i)
+    {
+        m_hits[i] = 0;
+        m_misses[i] = 0;
+    }
+}
+
+WorldPacket const* QueryResponseCache::Find(QueryCacheType type, uint32 entry, int loc_idx)
+{
+    ResponseMap::const_iterator itr = m_responses[type].find(MakeKey(entry, loc_idx));
+    if (itr == m_responses[type].end())
+    {
+        ++m_misses[type];
+        return NULL;
+    }
+
+    ++m_hits[type];
+    return &itr->second;
+}
+
+WorldPacket& QueryResponseCache::Add(QueryCacheType type, uint32 entry, int loc_idx, uint16 opcode, size_t reserve)
+{
+    WorldPacket& data = m_responses[type][MakeKey(entry, loc_idx)];
+    data.Initialize(opcode, reserve);
+    return data;
+}
+
+void QueryResponseCache::Clear(QueryCacheType type)
+{
+    m_responses[type].clear();
+}
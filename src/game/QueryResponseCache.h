@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2005-2010 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_QUERYRESPONSECACHE_H
+#define MANGOS_QUERYRESPONSECACHE_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+#include "Utilities/UnorderedMapSet.h"
+#include "WorldPacket.h"
+
+enum QueryCacheType
+{
+    QUERY_CACHE_CREATURE    = 0,                            // SMSG_CREATURE_QUERY_RESPONSE
+    QUERY_CACHE_GAMEOBJECT  = 1,                            // SMSG_GAMEOBJECT_QUERY_RESPONSE
+    QUERY_CACHE_ITEM        = 2,                            // SMSG_ITEM_QUERY_SINGLE_RESPONSE
+    QUERY_CACHE_QUEST       = 3,                            // SMSG_QUEST_QUERY_RESPONSE
+    QUERY_CACHE_NPC_TEXT    = 4,                            // SMSG_NPC_TEXT_UPDATE
+    QUERY_CACHE_PAGE_TEXT   = 5,                            // SMSG_PAGE_TEXT_QUERY_RESPONSE
+};
+
+#define MAX_QUERY_CACHE_TYPE 6
+
+/**
+ * Serialized responses for query opcodes that depend only on static (template and locale) data.
+ * Filled at first request for entry in locale, and sent as is for next requests of any session
+ * with same locale. Related data reload must clear cache of type (see ObjectMgr loaders).
+ * Used from world thread only (session packet handlers).
+ */
+class QueryResponseCache
+{
+    public:
+        QueryResponseCache();
+
+        // NULL if response not cached yet, loc_idx is session db locale index (-1 for default)
+        WorldPacket const* Find(QueryCacheType type, uint32 entry, int loc_idx);
+
+        // new empty packet for fill and send, stored for later Find calls
+        WorldPacket& Add(QueryCacheType type, uint32 entry, int loc_idx, uint16 opcode, size_t reserve);
+
+        void Clear(QueryCacheType type);
+
+        size_t GetSize(QueryCacheType type) const { return m_responses[type].size(); }
+        uint32 GetHits(QueryCacheType type) const { return m_hits[type]; }
+        uint32 GetMisses(QueryCacheType type) const { return m_misses[type]; }
+
+    private:
+        typedef UNORDERED_MAP<uint64, WorldPacket> ResponseMap;
+
+        static uint64 MakeKey(uint32 entry, int loc_idx) { return (uint64(loc_idx + 1) << 32) | entry; }
+
+        ResponseMap m_responses[MAX_QUERY_CACHE_TYPE];
+        uint32 m_hits[MAX_QUERY_CACHE_TYPE];
+        uint32 m_misses[MAX_QUERY_CACHE_TYPE];
+};
+
+#define sQueryResponseCache MaNGOS::Singleton<QueryResponseCache>::Instance()
+
+#endif
@@ -654,14 +654,14 @@ void WorldSession::HandleQuestgiverStatusMultipleQuery(WorldPacket& /*recvPacket
     WorldPacket data(SMSG_QUESTGIVER_STATUS_MULTIPLE, 4);
     data << uint32(count);                                  // placeholder
 
-    for(ObjectGuidSet::const_iterator itr = _player->m_clientGUIDs.begin(); itr != _player->m_clientGUIDs.end(); ++itr)
+    for(Player::ClientGUIDs::const_iterator itr = _player->m_clientGUIDs.begin(); itr != _player->m_clientGUIDs.end(); ++itr)
     {
         uint8 dialogStatus = DIALOG_STATUS_NONE;
 
-        if (itr->IsCreatureOrPet())
+        if (itr->first.IsCreatureOrPet())
         {
             // need also pet quests case support
-            Creature *questgiver = GetPlayer()->GetMap()->GetAnyTypeCreature(*itr);
+            Creature *questgiver = GetPlayer()->GetMap()->GetAnyTypeCreature(itr->first);
 
             if (!questgiver || questgiver->IsHostileTo(_player))
                 continue;
@@ -678,9 +678,9 @@ void WorldSession::HandleQuestgiverStatusMultipleQuery(WorldPacket& /*recvPacket
             data << uint8(dialogStatus);
             ++count;
         }
-        else if (itr->IsGameobject())
+        else if (itr->first.IsGameobject())
         {
-            GameObject *questgiver = GetPlayer()->GetMap()->GetGameObject(*itr);
+            GameObject *questgiver = GetPlayer()->GetMap()->GetGameObject(itr->first);
 
             if (!questgiver)
                 continue;
@@ -26,6 +26,7 @@
 #include "LootMgr.h"
 #include "Unit.h"
 #include "Player.h"
+#include "Policies/PoolAllocation.h"
 
 class WorldSession;
 class WorldPacket;
@@ -217,7 +218,7 @@ enum SpellTargets
 
 typedef std::multimap<uint64, uint64> SpellTargetTimeMap;
 
-class Spell
+class Spell : public MaNGOS::PoolAllocation<Spell>
 {
     friend struct MaNGOS::SpellNotifierPlayer;
     friend struct MaNGOS::SpellNotifierCreatureAndPlayer;
@@ -689,100 +690,131 @@ namespace MaNGOS
         }
 
         template<class T> inline void Visit(GridRefManager<T>  &m)
+        {
+            for(typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+                VisitUnit(itr->getSource());
+        }
+
+        void VisitUnit(Unit* target)
         {
             ASSERT(i_data);
 
             if(!i_originalCaster)
                 return;
 
-            for(typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
-            {
-                // there are still more spells which can be casted on dead, but
-                // they are no AOE and don't have such a nice SPELL_ATTR flag
-                if ( (i_TargetType != SPELL_TARGETS_ALL && !itr->getSource()->isTargetableForAttack(i_spell.m_spellInfo->AttributesEx3 & SPELL_ATTR_EX3_CAST_ON_DEAD))
-                    // mostly phase check
-                    || !itr->getSource()->IsInMap(i_originalCaster))
-                    continue;
+            // there are still more spells which can be casted on dead, but
+            // they are no AOE and don't have such a nice SPELL_ATTR flag
+            if ( (i_TargetType != SPELL_TARGETS_ALL && !target->isTargetableForAttack(i_spell.m_spellInfo->AttributesEx3 & SPELL_ATTR_EX3_CAST_ON_DEAD))
+                // mostly phase check
+                || !target->IsInMap(i_originalCaster))
+                return;
 
-                switch (i_TargetType)
+            switch (i_TargetType)
+            {
+                case SPELL_TARGETS_HOSTILE:
+                    if (!i_originalCaster->IsHostileTo( target ))
+                        return;
+                    break;
+                case SPELL_TARGETS_NOT_FRIENDLY:
+                    if (i_originalCaster->IsFriendlyTo( target ))
+                        return;
+                    break;
+                case SPELL_TARGETS_NOT_HOSTILE:
+                    if (i_originalCaster->IsHostileTo( target ))
+                        return;
+                    break;
+                case SPELL_TARGETS_FRIENDLY:
+                    if (!i_originalCaster->IsFriendlyTo( target ))
+                        return;
+                    break;
+                case SPELL_TARGETS_AOE_DAMAGE:
                 {
-                    case SPELL_TARGETS_HOSTILE:
-                        if (!i_originalCaster->IsHostileTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_NOT_FRIENDLY:
-                        if (i_originalCaster->IsFriendlyTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_NOT_HOSTILE:
-                        if (i_originalCaster->IsHostileTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_FRIENDLY:
-                        if (!i_originalCaster->IsFriendlyTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_AOE_DAMAGE:
+                    if(target->GetTypeId()==TYPEID_UNIT && ((Creature*)target)->isTotem())
+                        return;
+
+                    if (i_playerControled)
                     {
-                        if(itr->getSource()->GetTypeId()==TYPEID_UNIT && ((Creature*)itr->getSource())->isTotem())
-                            continue;
-
-                        if (i_playerControled)
-                        {
-                            if (i_originalCaster->IsFriendlyTo( itr->getSource() ))
-                                continue;
-                        }
-                        else
-                        {
-                            if (!i_originalCaster->IsHostileTo( itr->getSource() ))
-                                continue;
-                        }
+                        if (i_originalCaster->IsFriendlyTo( target ))
+                            return;
+                    }
+                    else
+                    {
+                        if (!i_originalCaster->IsHostileTo( target ))
+                            return;
                     }
-                    break;
-                    case SPELL_TARGETS_ALL:
-                        break;
-                    default: continue;
                 }
+                break;
+                case SPELL_TARGETS_ALL:
+                    break;
+                default: return;
+            }
 
-                // we don't need to check InMap here, it's already done some lines above
-                switch(i_push_type)
-                {
-                    case PUSH_IN_FRONT:
-                        if(i_spell.GetCaster()->isInFront((Unit*)(itr->getSource()), i_radius, 2*M_PI_F/3 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_90:
-                        if(i_spell.GetCaster()->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F/2 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_30:
-                        if(i_spell.GetCaster()->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F/6 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_15:
-                        if(i_spell.GetCaster()->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F/12 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_BACK:
-                        if(i_spell.GetCaster()->isInBack((Unit*)(itr->getSource()), i_radius, 2*M_PI_F/3 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_SELF_CENTER:
-                        if(i_spell.GetCaster()->IsWithinDist((Unit*)(itr->getSource()), i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_DEST_CENTER:
-                        if(itr->getSource()->IsWithinDist3d(i_spell.m_targets.m_destX, i_spell.m_targets.m_destY, i_spell.m_targets.m_destZ,i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_TARGET_CENTER:
-                        if(i_spell.m_targets.getUnitTarget()->IsWithinDist((Unit*)(itr->getSource()), i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                }
+            // we don't need to check InMap here, it's already done some lines above
+            switch(i_push_type)
+            {
+                case PUSH_IN_FRONT:
+                    if(i_spell.GetCaster()->isInFront(target, i_radius, 2*M_PI_F/3 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_FRONT_90:
+                    if(i_spell.GetCaster()->isInFront(target, i_radius, M_PI_F/2 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_FRONT_30:
+                    if(i_spell.GetCaster()->isInFront(target, i_radius, M_PI_F/6 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_FRONT_15:
+                    if(i_spell.GetCaster()->isInFront(target, i_radius, M_PI_F/12 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_BACK:
+                    if(i_spell.GetCaster()->isInBack(target, i_radius, 2*M_PI_F/3 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_SELF_CENTER:
+                    if(i_spell.GetCaster()->IsWithinDist(target, i_radius))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_DEST_CENTER:
+                    if(target->IsWithinDist3d(i_spell.m_targets.m_destX, i_spell.m_targets.m_destY, i_spell.m_targets.m_destZ,i_radius))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_TARGET_CENTER:
+                    if(i_spell.m_targets.getUnitTarget()->IsWithinDist(target, i_radius))
+                        i_data->push_back(target);
+                    break;
             }
         }
 
+        // 2d circle that contains all targets pushed by VisitUnit (+target bounding radius), for UnitSpatialIndex query
+        bool GetSearchArea(float& x, float& y, float& radius) const
+        {
+            WorldObject const* center;
+            switch(i_push_type)
+            {
+                case PUSH_DEST_CENTER:
+                    x = i_spell.m_targets.m_destX;
+                    y = i_spell.m_targets.m_destY;
+                    radius = i_radius;
+                    return true;
+                case PUSH_TARGET_CENTER:
+                    center = i_spell.m_targets.getUnitTarget();
+                    break;
+                default:
+                    center = i_spell.GetCaster();
+                    break;
+            }
+
+            if (!center)
+                return false;
+
+            x = center->GetPositionX();
+            y = center->GetPositionY();
+            radius = i_radius + center->GetObjectBoundingRadius();
+            return true;
+        }
+
         #ifdef WIN32
         template<> inline void Visit(CorpseMapType & ) {}
         template<> inline void Visit(GameObjectMapType & ) {}
@@ -466,7 +466,7 @@ Unit *caster, Item* castItem) : Aura(spellproto, eff, currentBasePoints, holder,
     // caster==NULL in constructor args if target==caster in fact
     Unit* caster_ptr = caster ? caster : target;
 
-    m_radius = GetSpellRadius(sSpellRadiusStore.LookupEntry(spellproto->EffectRadiusIndex[m_effIndex]));
+    m_radius = GetSpellEffectRadius(spellproto, m_effIndex);
     if(Player* modOwner = caster_ptr->GetSpellModOwner())
         modOwner->ApplySpellMod(spellproto->Id, SPELLMOD_RADIUS, m_radius);
 
@@ -568,6 +568,14 @@ void Aura::SetModifier(AuraType t, int32 a, uint32 pt, int32 miscValue)
     m_modifier.periodictime = pt;
 }
 
+void Aura::ChangeAmount(int32 amount)
+{
+    m_modifier.m_amount = amount;
+
+    // cached modifier sums for aura type must be recalculated
+    GetTarget()->InvalidateAuraAggregates(m_modifier.m_auraname);
+}
+
 void Aura::Update(uint32 diff)
 {
     if (m_duration > 0)
@@ -891,7 +899,12 @@ void Aura::ApplyModifier(bool apply, bool Real)
     GetHolder()->SetInUse(true);
     SetInUse(true);
     if(aura < TOTAL_AURAS)
+    {
+        // amount can be changed before apply and in handler
+        GetTarget()->InvalidateAuraAggregates(aura);
         (*this.*AuraHandler [aura])(apply, Real);
+        GetTarget()->InvalidateAuraAggregates(aura);
+    }
     SetInUse(false);
     GetHolder()->SetInUse(false);
 }
@@ -1674,14 +1687,14 @@ void Aura::TriggerSpell()
                         // Reset reapply counter at move
                         if (((Player*)triggerTarget)->isMoving())
                         {
-                            m_modifier.m_amount = 6;
+                            ChangeAmount(6);
                             return;
                         }
 
                         // We are standing at the moment
                         if (m_modifier.m_amount > 0)
                         {
-                            --m_modifier.m_amount;
+                            ChangeAmount(m_modifier.m_amount - 1);
                             return;
                         }
 
@@ -4943,6 +4956,8 @@ void Aura::HandlePeriodicHealthFunnel(bool apply, bool /*Real*/)
 
 void Aura::HandleAuraModResistanceExclusive(bool apply, bool /*Real*/)
 {
+    GetTarget()->BeginStatUpdateBatch();
+
     for(int8 x = SPELL_SCHOOL_NORMAL; x < MAX_SPELL_SCHOOL;x++)
     {
         if(m_modifier.m_miscvalue & int32(1<<x))
@@ -4952,10 +4967,14 @@ void Aura::HandleAuraModResistanceExclusive(bool apply, bool /*Real*/)
                 GetTarget()->ApplyResistanceBuffModsMod(SpellSchools(x), m_positive, float(m_modifier.m_amount), apply);
         }
     }
+
+    GetTarget()->EndStatUpdateBatch();
 }
 
 void Aura::HandleAuraModResistance(bool apply, bool /*Real*/)
 {
+    GetTarget()->BeginStatUpdateBatch();
+
     for(int8 x = SPELL_SCHOOL_NORMAL; x < MAX_SPELL_SCHOOL;x++)
     {
         if(m_modifier.m_miscvalue & int32(1<<x))
@@ -4965,6 +4984,8 @@ void Aura::HandleAuraModResistance(bool apply, bool /*Real*/)
                 GetTarget()->ApplyResistanceBuffModsMod(SpellSchools(x), m_positive, float(m_modifier.m_amount), apply);
         }
     }
+
+    GetTarget()->EndStatUpdateBatch();
 }
 
 void Aura::HandleAuraModBaseResistancePCT(bool apply, bool /*Real*/)
@@ -4978,11 +4999,15 @@ void Aura::HandleAuraModBaseResistancePCT(bool apply, bool /*Real*/)
     }
     else
     {
+        GetTarget()->BeginStatUpdateBatch();
+
         for(int8 x = SPELL_SCHOOL_NORMAL; x < MAX_SPELL_SCHOOL;x++)
         {
             if(m_modifier.m_miscvalue & int32(1<<x))
                 GetTarget()->HandleStatModifier(UnitMods(UNIT_MOD_RESISTANCE_START + x), BASE_PCT, float(m_modifier.m_amount), apply);
         }
+
+        GetTarget()->EndStatUpdateBatch();
     }
 }
 
@@ -4990,6 +5015,8 @@ void Aura::HandleModResistancePercent(bool apply, bool /*Real*/)
 {
     Unit *target = GetTarget();
 
+    target->BeginStatUpdateBatch();
+
     for(int8 i = SPELL_SCHOOL_NORMAL; i < MAX_SPELL_SCHOOL; i++)
     {
         if(m_modifier.m_miscvalue & int32(1<<i))
@@ -5002,6 +5029,8 @@ void Aura::HandleModResistancePercent(bool apply, bool /*Real*/)
             }
         }
     }
+
+    target->EndStatUpdateBatch();
 }
 
 void Aura::HandleModBaseResistance(bool apply, bool /*Real*/)
@@ -5015,9 +5044,13 @@ void Aura::HandleModBaseResistance(bool apply, bool /*Real*/)
     }
     else
     {
+        GetTarget()->BeginStatUpdateBatch();
+
         for(int i = SPELL_SCHOOL_NORMAL; i < MAX_SPELL_SCHOOL; i++)
             if(m_modifier.m_miscvalue & (1<<i))
                 GetTarget()->HandleStatModifier(UnitMods(UNIT_MOD_RESISTANCE_START + i), TOTAL_VALUE, float(m_modifier.m_amount), apply);
+
+        GetTarget()->EndStatUpdateBatch();
     }
 }
 
@@ -5033,6 +5066,8 @@ void Aura::HandleAuraModStat(bool apply, bool /*Real*/)
         return;
     }
 
+    GetTarget()->BeginStatUpdateBatch();
+
     for(int32 i = STAT_STRENGTH; i < MAX_STATS; i++)
     {
         // -1 or -2 is all stats ( misc < -2 checked in function beginning )
@@ -5044,6 +5079,8 @@ void Aura::HandleAuraModStat(bool apply, bool /*Real*/)
                 GetTarget()->ApplyStatBuffMod(Stats(i), float(m_modifier.m_amount), apply);
         }
     }
+
+    GetTarget()->EndStatUpdateBatch();
 }
 
 void Aura::HandleModPercentStat(bool apply, bool /*Real*/)
@@ -5058,11 +5095,15 @@ void Aura::HandleModPercentStat(bool apply, bool /*Real*/)
     if (GetTarget()->GetTypeId() != TYPEID_PLAYER)
         return;
 
+    GetTarget()->BeginStatUpdateBatch();
+
     for (int32 i = STAT_STRENGTH; i < MAX_STATS; ++i)
     {
         if(m_modifier.m_miscvalue == i || m_modifier.m_miscvalue == -1)
             GetTarget()->HandleStatModifier(UnitMods(UNIT_MOD_STAT_START + i), BASE_PCT, float(m_modifier.m_amount), apply);
     }
+
+    GetTarget()->EndStatUpdateBatch();
 }
 
 void Aura::HandleModSpellDamagePercentFromStat(bool /*apply*/, bool /*Real*/)
@@ -5137,6 +5178,8 @@ void Aura::HandleModTotalPercentStat(bool apply, bool /*Real*/)
     uint32 curHPValue = target->GetHealth();
     uint32 maxHPValue = target->GetMaxHealth();
 
+    target->BeginStatUpdateBatch();
+
     for (int32 i = STAT_STRENGTH; i < MAX_STATS; i++)
     {
         if(m_modifier.m_miscvalue == i || m_modifier.m_miscvalue == -1)
@@ -5147,6 +5190,8 @@ void Aura::HandleModTotalPercentStat(bool apply, bool /*Real*/)
         }
     }
 
+    target->EndStatUpdateBatch();
+
     //recalculate current HP/MP after applying aura modifications (only for spells with 0x10 flag)
     if ((m_modifier.m_miscvalue == STAT_STAMINA) && (maxHPValue > 0) && (GetSpellProto()->Attributes & 0x10))
     {
@@ -7237,7 +7282,7 @@ void Aura::PeriodicDummyTick()
                 // Search SPELL_AURA_MOD_POWER_REGEN aura for this spell and add bonus
                 if (Aura* aura = GetHolder()->GetAuraByEffectIndex(SpellEffectIndex(GetEffIndex() - 1)))
                 {
-                    aura->GetModifier()->m_amount = m_modifier.m_amount;
+                    aura->ChangeAmount(m_modifier.m_amount);
                     ((Player*)target)->UpdateManaRegen();
                     // Disable continue
                     m_isPeriodic = false;
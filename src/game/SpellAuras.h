@@ -20,6 +20,7 @@
 
 #include "SpellAuraDefines.h"
 #include "DBCEnums.h"
+#include "Policies/PoolAllocation.h"
 
 struct Modifier
 {
@@ -40,7 +41,7 @@ class Aura;
 // internal helper
 struct ReapplyAffectedPassiveAurasHelper;
 
-class MANGOS_DLL_SPEC SpellAuraHolder
+class MANGOS_DLL_SPEC SpellAuraHolder : public MaNGOS::PoolAllocation<SpellAuraHolder>
 {
     public:
         SpellAuraHolder (SpellEntry const* spellproto, Unit *target, WorldObject *caster, Item *castItem);
@@ -195,7 +196,7 @@ typedef void(Aura::*pAuraHandler)(bool Apply, bool Real);
 //      each setting object update field code line moved under if(Real) check is significant mangos speedup, and less server->client data sends
 //      each packet sending code moved under if(Real) check is _large_ mangos speedup, and lot less server->client data sends
 
-class MANGOS_DLL_SPEC Aura
+class MANGOS_DLL_SPEC Aura : public MaNGOS::PoolAllocation<Aura>
 {
     friend struct ReapplyAffectedPassiveAurasHelper;
     friend Aura* CreateAura(SpellEntry const* spellproto, SpellEffectIndex eff, int32 *currentBasePoints, SpellAuraHolder *holder, Unit *target, Unit *caster, Item* castItem);
@@ -366,6 +367,7 @@ class MANGOS_DLL_SPEC Aura
         virtual ~Aura();
 
         void SetModifier(AuraType t, int32 a, uint32 pt, int32 miscValue);
+        void ChangeAmount(int32 amount);                    // for already applied modifier
         Modifier*       GetModifier()       { return &m_modifier; }
         Modifier const* GetModifier() const { return &m_modifier; }
         int32 GetMiscValue() const { return m_spellAuraHolder->GetSpellProto()->EffectMiscValue[m_effIndex]; }
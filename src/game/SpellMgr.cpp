@@ -27,7 +27,7 @@
 #include "BattleGroundMgr.h"
 #include "MapManager.h"
 
-SpellMgr::SpellMgr()
+SpellMgr::SpellMgr() : m_spellProcEventsVersion(0)
 {
 }
 
@@ -41,24 +41,38 @@ SpellMgr& SpellMgr::Instance()
     return spellMgr;
 }
 
-int32 GetSpellDuration(SpellEntry const *spellInfo)
+// durationIdx: 0 for base duration, 2 for max duration
+static int32 CalculateSpellDuration(SpellEntry const *spellInfo, int durationIdx)
 {
-    if(!spellInfo)
-        return 0;
     SpellDurationEntry const *du = sSpellDurationStore.LookupEntry(spellInfo->DurationIndex);
     if(!du)
         return 0;
-    return (du->Duration[0] == -1) ? -1 : abs(du->Duration[0]);
+    return (du->Duration[durationIdx] == -1) ? -1 : abs(du->Duration[durationIdx]);
 }
 
-int32 GetSpellMaxDuration(SpellEntry const *spellInfo)
+int32 GetSpellDuration(SpellEntry const *spellInfo)
 {
     if(!spellInfo)
         return 0;
-    SpellDurationEntry const *du = sSpellDurationStore.LookupEntry(spellInfo->DurationIndex);
-    if(!du)
+    if(SpellInfo const* info = sSpellMgr.GetSpellInfo(spellInfo->Id))
+        return info->duration;
+    return CalculateSpellDuration(spellInfo, 0);
+}
+
+int32 GetSpellMaxDuration(SpellEntry const *spellInfo)
+{
+    if(!spellInfo)
         return 0;
-    return (du->Duration[2] == -1) ? -1 : abs(du->Duration[2]);
+    if(SpellInfo const* info = sSpellMgr.GetSpellInfo(spellInfo->Id))
+        return info->maxDuration;
+    return CalculateSpellDuration(spellInfo, 2);
+}
+
+float GetSpellEffectRadius(SpellEntry const* spellInfo, SpellEffectIndex effIndex)
+{
+    if(SpellInfo const* info = sSpellMgr.GetSpellInfo(spellInfo->Id))
+        return info->effectRadius[effIndex];
+    return GetSpellRadius(sSpellRadiusStore.LookupEntry(spellInfo->EffectRadiusIndex[effIndex]));
 }
 
 uint32 GetSpellCastTime(SpellEntry const* spellInfo, Spell const* spell)
@@ -333,11 +347,8 @@ int32 CompareAuraRanks(uint32 spellId_1, uint32 spellId_2)
     return 0;
 }
 
-SpellSpecific GetSpellSpecific(uint32 spellId)
+static SpellSpecific CalculateSpellSpecific(SpellEntry const *spellInfo)
 {
-    SpellEntry const *spellInfo = sSpellStore.LookupEntry(spellId);
-    if(!spellInfo)
-        return SPELL_NORMAL;
 
     switch(spellInfo->SpellFamilyName)
     {
@@ -489,6 +500,18 @@ SpellSpecific GetSpellSpecific(uint32 spellId)
     return SPELL_NORMAL;
 }
 
+SpellSpecific GetSpellSpecific(uint32 spellId)
+{
+    if(SpellInfo const* info = sSpellMgr.GetSpellInfo(spellId))
+        return SpellSpecific(info->spellSpecific);
+
+    SpellEntry const *spellInfo = sSpellStore.LookupEntry(spellId);
+    if(!spellInfo)
+        return SPELL_NORMAL;
+
+    return CalculateSpellSpecific(spellInfo);
+}
+
 
 // target not allow have more one spell specific from same caster
 bool IsSingleFromSpellSpecificPerTargetPerCaster(SpellSpecific spellSpec1,SpellSpecific spellSpec2)
@@ -622,10 +645,9 @@ bool IsExplicitNegativeTarget(uint32 targetA)
     return false;
 }
 
-bool IsPositiveEffect(uint32 spellId, SpellEffectIndex effIndex)
+static bool CalculatePositiveEffect(SpellEntry const *spellproto, SpellEffectIndex effIndex)
 {
-    SpellEntry const *spellproto = sSpellStore.LookupEntry(spellId);
-    if (!spellproto) return false;
+    uint32 spellId = spellproto->Id;
 
     switch(spellproto->Effect[effIndex])
     {
@@ -838,8 +860,22 @@ bool IsPositiveEffect(uint32 spellId, SpellEffectIndex effIndex)
     return true;
 }
 
+bool IsPositiveEffect(uint32 spellId, SpellEffectIndex effIndex)
+{
+    if (SpellInfo const* info = sSpellMgr.GetSpellInfo(spellId))
+        return info->positiveEffectMask & (1 << effIndex);
+
+    SpellEntry const *spellproto = sSpellStore.LookupEntry(spellId);
+    if (!spellproto) return false;
+
+    return CalculatePositiveEffect(spellproto, effIndex);
+}
+
 bool IsPositiveSpell(uint32 spellId)
 {
+    if (SpellInfo const* info = sSpellMgr.GetSpellInfo(spellId))
+        return info->positiveEffectMask == (1 << MAX_EFFECT_INDEX) - 1;
+
     SpellEntry const *spellproto = sSpellStore.LookupEntry(spellId);
     if (!spellproto)
         return false;
@@ -1098,6 +1134,7 @@ struct DoSpellProcEvent
 void SpellMgr::LoadSpellProcEvents()
 {
     mSpellProcEventMap.clear();                             // need for reload case
+    ++m_spellProcEventsVersion;                             // units proc indexes must be rebuilt
 
     uint32 count = 0;
 
@@ -1543,6 +1580,7 @@ bool SpellMgr::IsSpellProcEventCanTriggeredBy(SpellProcEventEntry const * spellP
 void SpellMgr::LoadSpellElixirs()
 {
     mSpellElixirs.clear();                                  // need for reload case
+    mSpellInfoTable.clear();                                // precomputed spell specific, rebuild after reload
 
     uint32 count = 0;
 
@@ -2315,6 +2353,7 @@ void SpellMgr::LoadSpellChains()
 {
     mSpellChains.clear();                                   // need for reload case
     mSpellChainsNext.clear();                               // need for reload case
+    mSpellInfoTable.clear();                                // precomputed chain data, rebuild after reload
 
     // load known data for talents
     for (unsigned int i = 0; i < sTalentStore.GetNumRows(); ++i)
@@ -2528,6 +2567,51 @@ void SpellMgr::LoadSpellChains()
     sLog.outString( ">> Loaded %u spell chain records", count );
 }
 
+void SpellMgr::LoadSpellInfoTable()
+{
+    SpellInfoTable table(sSpellStore.GetNumRows());
+    uint32 count = 0;
+
+    barGoLink bar(table.size());
+
+    for (uint32 spell_id = 0; spell_id < table.size(); ++spell_id)
+    {
+        bar.step();
+
+        SpellInfo& info = table[spell_id];
+
+        info.firstRankSpell = spell_id;
+        if (SpellChainNode const* node = GetSpellChainNode(spell_id))
+        {
+            info.firstRankSpell = node->first;
+            info.prevRankSpell = node->prev;
+            info.rank = node->rank;
+        }
+
+        SpellEntry const* spellInfo = sSpellStore.LookupEntry(spell_id);
+        if (!spellInfo)
+            continue;
+
+        info.duration = CalculateSpellDuration(spellInfo, 0);
+        info.maxDuration = CalculateSpellDuration(spellInfo, 2);
+        info.spellSpecific = uint8(CalculateSpellSpecific(spellInfo));
+
+        for (int i = 0; i < MAX_EFFECT_INDEX; ++i)
+        {
+            info.effectRadius[i] = GetSpellRadius(sSpellRadiusStore.LookupEntry(spellInfo->EffectRadiusIndex[i]));
+            if (CalculatePositiveEffect(spellInfo, SpellEffectIndex(i)))
+                info.positiveEffectMask |= (1 << i);
+        }
+
+        ++count;
+    }
+
+    mSpellInfoTable.swap(table);
+
+    sLog.outString();
+    sLog.outString( ">> Precomputed data for %u spells", count );
+}
+
 void SpellMgr::LoadSpellLearnSkills()
 {
     mSpellLearnSkills.clear();                              // need for reload case
@@ -111,6 +111,7 @@ SpellSpecific GetSpellSpecific(uint32 spellId);
 
 // Different spell properties
 inline float GetSpellRadius(SpellRadiusEntry const *radius) { return (radius ? radius->Radius : 0); }
+float GetSpellEffectRadius(SpellEntry const* spellInfo, SpellEffectIndex effIndex);
 uint32 GetSpellCastTime(SpellEntry const* spellInfo, Spell const* spell = NULL);
 uint32 GetSpellCastTimeForBonus( SpellEntry const *spellProto, DamageEffectType damagetype );
 float CalculateDefaultCoefficient(SpellEntry const *spellProto, DamageEffectType const damagetype);
@@ -810,6 +811,30 @@ inline bool IsProfessionOrRidingSkill(uint32 skill)
     return  IsProfessionSkill(skill) || skill == SKILL_RIDING;
 }
 
+// Spell data precomputed at load from SpellEntry, spell chains and elixirs, see SpellMgr::LoadSpellInfoTable
+// Used instead recalculation by often called helpers, 32 bytes for keep 2 entries in cache line
+struct SpellInfo
+{
+    SpellInfo() : duration(0), maxDuration(0), firstRankSpell(0), prevRankSpell(0),
+        rank(0), spellSpecific(SPELL_NORMAL), positiveEffectMask(0), reserved(0)
+    {
+        for(int i = 0; i < MAX_EFFECT_INDEX; ++i)
+            effectRadius[i] = 0.0f;
+    }
+
+    int32  duration;                                        // GetSpellDuration
+    int32  maxDuration;                                     // GetSpellMaxDuration
+    float  effectRadius[MAX_EFFECT_INDEX];                  // GetSpellEffectRadius
+    uint32 firstRankSpell;                                  // spell itself if not in chain
+    uint32 prevRankSpell;
+    uint8  rank;                                            // 0 if not in chain
+    uint8  spellSpecific;                                   // SpellSpecific
+    uint8  positiveEffectMask;                              // bit per IsPositiveEffect result
+    uint8  reserved;
+};
+
+typedef std::vector<SpellInfo> SpellInfoTable;
+
 class SpellMgr
 {
     friend struct DoSpellBonuses;
@@ -860,6 +885,8 @@ class SpellMgr
         }
 
         // Spell proc events
+        uint32 GetSpellProcEventsVersion() const { return m_spellProcEventsVersion; }
+
         SpellProcEventEntry const* GetSpellProcEvent(uint32 spellId) const
         {
             SpellProcEventMap::const_iterator itr = mSpellProcEventMap.find(spellId);
@@ -901,6 +928,12 @@ class SpellMgr
         }
 
         // Spell ranks chains
+        // NULL until LoadSpellInfoTable call or for spell id out of spell store range
+        SpellInfo const* GetSpellInfo(uint32 spell_id) const
+        {
+            return spell_id < mSpellInfoTable.size() ? &mSpellInfoTable[spell_id] : NULL;
+        }
+
         SpellChainNode const* GetSpellChainNode(uint32 spell_id) const
         {
             SpellChainMap::const_iterator itr = mSpellChains.find(spell_id);
@@ -912,6 +945,9 @@ class SpellMgr
 
         uint32 GetFirstSpellInChain(uint32 spell_id) const
         {
+            if(SpellInfo const* info = GetSpellInfo(spell_id))
+                return info->firstRankSpell;
+
             if(SpellChainNode const* node = GetSpellChainNode(spell_id))
                 return node->first;
 
@@ -920,6 +956,9 @@ class SpellMgr
 
         uint32 GetPrevSpellInChain(uint32 spell_id) const
         {
+            if(SpellInfo const* info = GetSpellInfo(spell_id))
+                return info->prevRankSpell;
+
             if(SpellChainNode const* node = GetSpellChainNode(spell_id))
                 return node->prev;
 
@@ -943,6 +982,9 @@ class SpellMgr
         // Use IsHighRankOfSpell instead
         uint8 GetSpellRank(uint32 spell_id) const
         {
+            if(SpellInfo const* info = GetSpellInfo(spell_id))
+                return info->rank;
+
             if(SpellChainNode const* node = GetSpellChainNode(spell_id))
                 return node->rank;
 
@@ -1107,6 +1149,7 @@ class SpellMgr
         void LoadPetLevelupSpellMap();
         void LoadPetDefaultSpells();
         void LoadSpellAreas();
+        void LoadSpellInfoTable();                          // must be after LoadSpellChains and LoadSpellElixirs
 
     private:
         bool LoadPetDefaultSpells_helper(CreatureInfo const* cInfo, PetDefaultSpellsEntry& petDefSpells);
@@ -1120,6 +1163,7 @@ class SpellMgr
         SpellElixirMap     mSpellElixirs;
         SpellThreatMap     mSpellThreatMap;
         SpellProcEventMap  mSpellProcEventMap;
+        uint32             m_spellProcEventsVersion;        // increased at each (re)load, see Unit::m_procHolders
         SpellProcItemEnchantMap mSpellProcItemEnchantMap;
         SpellBonusMap      mSpellBonusMap;
         SkillLineAbilityMap mSkillLineAbilityMap;
@@ -1132,6 +1176,7 @@ class SpellMgr
         SpellAreaForQuestMap mSpellAreaForQuestEndMap;
         SpellAreaForAuraMap  mSpellAreaForAuraMap;
         SpellAreaForAreaMap  mSpellAreaForAreaMap;
+        SpellInfoTable       mSpellInfoTable;               // indexed by spell id
 };
 
 #define sSpellMgr SpellMgr::Instance()
@@ -75,7 +75,8 @@ void TargetedMovementGeneratorMedium<T,D>::_setTargetLocation(T &owner)
             return;
     */
     Traveller<T> traveller(owner);
-    i_destinationHolder.SetDestination(traveller, x, y, z);
+    // path rebuilt only if target moved out of pathfinder node of current path end
+    i_destinationHolder.SetDestination(traveller, x, y, z, true, true);
 
     D::_addUnitStateMove(owner);
     if (owner.GetTypeId() == TYPEID_UNIT && ((Creature*)&owner)->canFly())
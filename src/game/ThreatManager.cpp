@@ -57,6 +57,7 @@ HostileReference::HostileReference(Unit* pUnit, ThreatManager *pThreatManager, f
 {
     iThreat = pThreat;
     iTempThreatModifyer = 0.0f;
+    iClientThreat = uint32(-1);
     link(pUnit, pThreatManager);
     iUnitGuid = pUnit->GetGUID();
     iOnline = true;
@@ -216,6 +217,38 @@ void ThreatContainer::clearReferences()
     iThreatList.clear();
 }
 
+//============================================================
+
+void ThreatContainer::remove(HostileReference* pRef)
+{
+    // erase keep order of other references, so list stay sorted
+    ThreatList::iterator itr = std::find(iThreatList.begin(), iThreatList.end(), pRef);
+    if (itr != iThreatList.end())
+        iThreatList.erase(itr);
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* pHostileReference)
+{
+    // client forget reference at SMSG_THREAT_REMOVE, so it must be resent in full at next update
+    pHostileReference->resetClientThreat();
+    iThreatList.push_back(pHostileReference);
+    if (iThreatList.size() > 1)
+        iDirty = true;
+}
+
+//============================================================
+
+bool ThreatContainer::hasClientChanges() const
+{
+    for(ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+        if ((*i)->isClientThreatChanged())
+            return true;
+
+    return false;
+}
+
 //============================================================
 // Return the HostileReference of NULL, if not found
 HostileReference* ThreatContainer::getReferenceByTarget(Unit* pVictim)
@@ -255,20 +288,25 @@ void ThreatContainer::modifyThreatPercent(Unit *pVictim, int32 pPercent)
 
 //============================================================
 
-bool HostileReferenceSortPredicate(const HostileReference* lhs, const HostileReference* rhs)
-{
-    // std::list::sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
-    return lhs->getThreat() > rhs->getThreat();             // reverse sorting
-}
-
-//============================================================
 // Check if the list is dirty and sort if necessary
+// The list is kept sorted between updates and only few references change threat
+// between two updates, so stable insertion sort here is near linear and not reallocate
 
 void ThreatContainer::update()
 {
     if(iDirty && iThreatList.size() >1)
     {
-        iThreatList.sort(HostileReferenceSortPredicate);
+        for(size_t i = 1; i < iThreatList.size(); ++i)
+        {
+            HostileReference* ref = iThreatList[i];
+            float threat = ref->getThreat();
+
+            size_t j = i;
+            for(; j > 0 && iThreatList[j-1]->getThreat() < threat; --j)
+                iThreatList[j] = iThreatList[j-1];      // reverse sorting, most hated first
+
+            iThreatList[j] = ref;
+        }
     }
     iDirty = false;
 }
@@ -552,7 +590,9 @@ void ThreatManager::UpdateForClient(uint32 diff)
     iUpdateTimer.Update(diff);
     if (iUpdateTimer.Passed())
     {
-        iOwner->SendThreatUpdate();
+        // removed references already sent by SMSG_THREAT_REMOVE, skip resend of the same values
+        if (iThreatContainer.hasClientChanges())
+            iOwner->SendThreatUpdate();
         iUpdateTimer.Reset(THREAT_UPDATE_INTERVAL);
         iUpdateNeed = false;
     }
@@ -24,7 +24,7 @@
 #include "Utilities/LinkedReference/Reference.h"
 #include "UnitEvents.h"
 #include "Timer.h"
-#include <list>
+#include <vector>
 
 //==============================================================
 
@@ -79,6 +79,12 @@ class MANGOS_DLL_SPEC HostileReference : public Reference<Unit, ThreatManager>
 
         float getTempThreatModifyer() { return iTempThreatModifyer; }
 
+        //=================================================
+        // threat value last sent to client in SMSG_THREAT_UPDATE, for skip unchanged updates
+        bool isClientThreatChanged() const { return uint32(iThreat) != iClientThreat; }
+        void setClientThreatSent() { iClientThreat = uint32(iThreat); }
+        void resetClientThreat() { iClientThreat = uint32(-1); }
+
         //=================================================
         // check, if source can reach target and set the status
         void updateOnlineStatus();
@@ -121,6 +127,7 @@ class MANGOS_DLL_SPEC HostileReference : public Reference<Unit, ThreatManager>
     private:
         float iThreat;
         float iTempThreatModifyer;                          // used for taunt
+        uint32 iClientThreat;                               // uint32(-1) if client not know the reference
         uint64 iUnitGuid;
         bool iOnline;
         bool iAccessible;
@@ -129,7 +136,8 @@ class MANGOS_DLL_SPEC HostileReference : public Reference<Unit, ThreatManager>
 //==============================================================
 class ThreatManager;
 
-typedef std::list<HostileReference*> ThreatList;
+// kept sorted by threat in ThreatContainer::update, most hated first
+typedef std::vector<HostileReference*> ThreatList;
 
 
 class MANGOS_DLL_SPEC ThreatContainer
@@ -140,11 +148,13 @@ class MANGOS_DLL_SPEC ThreatContainer
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* pRef) { iThreatList.remove(pRef); }
-        void addReference(HostileReference* pHostileReference) { iThreatList.push_back(pHostileReference); }
+        void remove(HostileReference* pRef);
+        void addReference(HostileReference* pHostileReference);
         void clearReferences();
         // Sort the list if necessary
         void update();
+        // true if any reference threat changed since last send to client
+        bool hasClientChanges() const;
     public:
         ThreatContainer() { iDirty = false; }
         ~ThreatContainer() { clearReferences(); }
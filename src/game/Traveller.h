@@ -21,6 +21,7 @@
 
 #include "Creature.h"
 #include "Player.h"
+#include "World.h"
 #include <cassert>
 
 /** Traveller is a wrapper for units (creatures or players) that
@@ -49,6 +50,7 @@ struct MANGOS_DLL_DECL Traveller
     T& GetTraveller(void) { return i_traveller; }
 
     float Speed(void) { ASSERT(false); return 0.0f; }
+    bool UsePathfinding(void) const { return false; }
     float GetMoveDestinationTo(float x, float y, float z);
     uint32 GetTotalTrevelTimeTo(float x, float y, float z);
 
@@ -80,6 +82,13 @@ inline float Traveller<Creature>::Speed()
         return i_traveller.GetSpeed(MOVE_RUN);
 }
 
+template<>
+inline bool Traveller<Creature>::UsePathfinding() const
+{
+    // flying creatures move in direct line anyway
+    return sWorld.getConfig(CONFIG_BOOL_PATHFINDING_ENABLED) && !i_traveller.canFly() && !i_traveller.hasUnitState(UNIT_STAT_TAXI_FLIGHT);
+}
+
 template<>
 inline void Traveller<Creature>::Relocation(float x, float y, float z, float orientation)
 {
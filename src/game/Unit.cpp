@@ -49,6 +49,7 @@
 #include "Traveller.h"
 #include "VMapFactory.h"
 #include "MovementGenerator.h"
+#include "UnitSpatialIndex.h"
 
 #include <math.h>
 #include <stdarg.h>
@@ -192,6 +193,8 @@ Unit::Unit()
     //m_AurasCheck = 2000;
     //m_removeAuraTimer = 4;
     m_spellAuraHoldersUpdateIterator = m_spellAuraHolders.end();
+    m_procHoldersFlags = 0;
+    m_procHoldersVersion = sSpellMgr.GetSpellProcEventsVersion();
     m_AuraFlags = 0;
 
     m_Visibility = VISIBILITY_ON;
@@ -201,6 +204,8 @@ Unit::Unit()
     m_transform = 0;
     m_ShapeShiftFormSpellId = 0;
     m_canModifyStats = false;
+    m_statUpdateBatch = 0;
+    m_deferredStatMods = 0;
 
     for (int i = 0; i < MAX_SPELL_IMMUNITY; ++i)
         m_spellImmune[i].clear();
@@ -2144,9 +2149,7 @@ void Unit::CalculateAbsorbAndResist(Unit *pCaster, SpellSchoolMask schoolMask, D
             incanterAbsorption += currentAbsorb;
 
         // Reduce shield amount
-        mod->m_amount-=currentAbsorb;
-        if((*i)->GetHolder()->DropAuraCharge())
-            mod->m_amount = 0;
+        (*i)->ChangeAmount((*i)->GetHolder()->DropAuraCharge() ? 0 : mod->m_amount - currentAbsorb);
         // Need remove it later
         if (mod->m_amount<=0)
             existExpired = true;
@@ -2205,7 +2208,7 @@ void Unit::CalculateAbsorbAndResist(Unit *pCaster, SpellSchoolMask schoolMask, D
         if ((*i)->GetSpellProto()->SpellFamilyName == SPELLFAMILY_MAGE && (*i)->GetSpellProto()->SpellFamilyFlags2 & 0x000008)
             incanterAbsorption += currentAbsorb;
 
-        (*i)->GetModifier()->m_amount -= currentAbsorb;
+        (*i)->ChangeAmount((*i)->GetModifier()->m_amount - currentAbsorb);
         if((*i)->GetModifier()->m_amount <= 0)
         {
             RemoveAurasDueToSpell((*i)->GetId());
@@ -3644,57 +3647,71 @@ void Unit::DeMorph()
     SetDisplayId(GetNativeDisplayId());
 }
 
-int32 Unit::GetTotalAuraModifier(AuraType auratype) const
+AuraTypeAggregates& Unit::GetAuraTypeAggregates(AuraType auratype) const
 {
-    int32 modifier = 0;
+    AuraAggregatesMap::iterator itr = m_auraAggregates.find(auratype);
+    if (itr != m_auraAggregates.end())
+        return itr->second;
+
+    AuraTypeAggregates& aggregates = m_auraAggregates[auratype];
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for(AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
-        modifier += (*i)->GetModifier()->m_amount;
+    {
+        int32 amount = (*i)->GetModifier()->m_amount;
+        aggregates.total += amount;
+        aggregates.multiplier *= (100.0f + amount)/100.0f;
+        if (amount > aggregates.maxPositive)
+            aggregates.maxPositive = amount;
+        if (amount < aggregates.maxNegative)
+            aggregates.maxNegative = amount;
+    }
 
-    return modifier;
+    return aggregates;
 }
 
-float Unit::GetTotalAuraMultiplier(AuraType auratype) const
+int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
-    float multiplier = 1.0f;
+    if (m_modAuras[auratype].empty())
+        return 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for(AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
-        multiplier *= (100.0f + (*i)->GetModifier()->m_amount)/100.0f;
+    return GetAuraTypeAggregates(auratype).total;
+}
 
-    return multiplier;
+float Unit::GetTotalAuraMultiplier(AuraType auratype) const
+{
+    if (m_modAuras[auratype].empty())
+        return 1.0f;
+
+    return GetAuraTypeAggregates(auratype).multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for(AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetModifier()->m_amount > modifier)
-            modifier = (*i)->GetModifier()->m_amount;
+    if (m_modAuras[auratype].empty())
+        return 0;
 
-    return modifier;
+    return GetAuraTypeAggregates(auratype).maxPositive;
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for(AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetModifier()->m_amount < modifier)
-            modifier = (*i)->GetModifier()->m_amount;
+    if (m_modAuras[auratype].empty())
+        return 0;
 
-    return modifier;
+    return GetAuraTypeAggregates(auratype).maxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    if(!misc_mask)
+    if(!misc_mask || m_modAuras[auratype].empty())
         return 0;
 
+    AuraTypeAggregates::MiscTotals& totals = GetAuraTypeAggregates(auratype).totalByMiscMask;
+    AuraTypeAggregates::MiscTotals::const_iterator itr = totals.find(int32(misc_mask));
+    if (itr != totals.end())
+        return itr->second;
+
     int32 modifier = 0;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
@@ -3704,6 +3721,8 @@ int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask)
         if (mod->m_miscvalue & misc_mask)
             modifier += mod->m_amount;
     }
+
+    totals[int32(misc_mask)] = modifier;
     return modifier;
 }
 
@@ -3762,6 +3781,14 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
+    if (m_modAuras[auratype].empty())
+        return 0;
+
+    AuraTypeAggregates::MiscTotals& totals = GetAuraTypeAggregates(auratype).totalByMiscValue;
+    AuraTypeAggregates::MiscTotals::const_iterator itr = totals.find(misc_value);
+    if (itr != totals.end())
+        return itr->second;
+
     int32 modifier = 0;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
@@ -3771,6 +3798,8 @@ int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value)
         if (mod->m_miscvalue == misc_value)
             modifier += mod->m_amount;
     }
+
+    totals[misc_value] = modifier;
     return modifier;
 }
 
@@ -4001,6 +4030,7 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder *holder)
     // add aura, register in lists and arrays
     holder->_AddSpellAuraHolder();
     m_spellAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
+    AddHolderToProcIndex(holder);
 
     for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         if (Aura *aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
@@ -4022,7 +4052,10 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder *holder)
 void Unit::AddAuraToModList(Aura *aura)
 {
     if (aura->GetModifier()->m_auraname < TOTAL_AURAS)
+    {
         m_modAuras[aura->GetModifier()->m_auraname].push_back(aura);
+        InvalidateAuraAggregates(aura->GetModifier()->m_auraname);
+    }
 }
 
 void Unit::RemoveRankAurasDueToSpell(uint32 spellId)
@@ -4574,6 +4607,8 @@ void Unit::RemoveSpellAuraHolder(SpellAuraHolder *holder, AuraRemoveMode mode)
         }
     }
 
+    RemoveHolderFromProcIndex(holder);
+
     holder->SetRemoveMode(mode);
     holder->UnregisterSingleCastHolder();
 
@@ -4625,6 +4660,7 @@ void Unit::RemoveAura(Aura *Aur, AuraRemoveMode mode)
     if (Aur->GetModifier()->m_auraname < TOTAL_AURAS)
     {
         m_modAuras[Aur->GetModifier()->m_auraname].remove(Aur);
+        InvalidateAuraAggregates(Aur->GetModifier()->m_auraname);
     }
 
     // Set remove mode
@@ -7676,26 +7712,26 @@ bool Unit::isVisibleForOrDetect(Unit const* u, WorldObject const* viewPoint, boo
         if(u->GetTypeId()==TYPEID_PLAYER)
         {
             // Players far than max visible distance for player or not in our map are not visible too
-            if (!at_same_transport && !IsWithinDistInMap(viewPoint, _map.GetVisibilityDistance() + (inVisibleList ? World::GetVisibleUnitGreyDistance() : 0.0f), is3dDistance))
+            if (!at_same_transport && !IsWithinDistInMap(viewPoint, _map.GetVisibilityDistance(viewPoint) + (inVisibleList ? World::GetVisibleUnitGreyDistance() : 0.0f), is3dDistance))
                 return false;
         }
         else
         {
             // Units far than max visible distance for creature or not in our map are not visible too
-            if (!IsWithinDistInMap(viewPoint, _map.GetVisibilityDistance() + (inVisibleList ? World::GetVisibleUnitGreyDistance() : 0.0f), is3dDistance))
+            if (!IsWithinDistInMap(viewPoint, _map.GetVisibilityDistance(viewPoint) + (inVisibleList ? World::GetVisibleUnitGreyDistance() : 0.0f), is3dDistance))
                 return false;
         }
     }
     else if(GetCharmerOrOwnerGUID())                        // distance for show pet/charmed
     {
         // Pet/charmed far than max visible distance for player or not in our map are not visible too
-        if (!IsWithinDistInMap(viewPoint, _map.GetVisibilityDistance() + (inVisibleList ? World::GetVisibleUnitGreyDistance() : 0.0f), is3dDistance))
+        if (!IsWithinDistInMap(viewPoint, _map.GetVisibilityDistance(viewPoint) + (inVisibleList ? World::GetVisibleUnitGreyDistance() : 0.0f), is3dDistance))
             return false;
     }
     else                                                    // distance for show creature
     {
         // Units far than max visible distance for creature or not in our map are not visible too
-        if (!IsWithinDistInMap(viewPoint, _map.GetVisibilityDistance() + (inVisibleList ? World::GetVisibleUnitGreyDistance() : 0.0f), is3dDistance))
+        if (!IsWithinDistInMap(viewPoint, _map.GetVisibilityDistance(viewPoint) + (inVisibleList ? World::GetVisibleUnitGreyDistance() : 0.0f), is3dDistance))
             return false;
     }
 
@@ -8806,6 +8842,12 @@ bool Unit::HandleStatModifier(UnitMods unitMod, UnitModifierType modifierType, f
     if(!CanModifyStats())
         return false;
 
+    if (m_statUpdateBatch)
+    {
+        m_deferredStatMods |= (1 << unitMod);
+        return true;
+    }
+
     switch(unitMod)
     {
         case UNIT_MOD_STAT_STRENGTH:
@@ -8846,6 +8888,65 @@ bool Unit::HandleStatModifier(UnitMods unitMod, UnitModifierType modifierType, f
     return true;
 }
 
+void Unit::EndStatUpdateBatch()
+{
+    ASSERT(m_statUpdateBatch > 0);
+
+    if (--m_statUpdateBatch > 0)
+        return;
+
+    uint32 mods = m_deferredStatMods;
+    m_deferredStatMods = 0;
+
+    if (!mods || !CanModifyStats())
+        return;
+
+    // primary stats first, their updates include derived values (armor, health, mana, attack power...)
+    uint32 statMods = mods & ((1 << UNIT_MOD_STAT_END) - 1);
+    if (statMods & (statMods - 1))
+    {
+        // several stats changed, single full recalculation cheaper
+        UpdateAllStats();
+        return;
+    }
+
+    for (int i = UNIT_MOD_STAT_START; i < UNIT_MOD_STAT_END; ++i)
+        if (mods & (1 << i))
+            UpdateStats(GetStatByAuraGroup(UnitMods(i)));
+
+    // armor before attack power, for SPELL_AURA_MOD_ATTACK_POWER_OF_ARMOR
+    for (int i = UNIT_MOD_RESISTANCE_START; i < UNIT_MOD_RESISTANCE_END; ++i)
+    {
+        if (mods & (1 << i))
+        {
+            if (i == UNIT_MOD_ARMOR)
+                UpdateArmor();
+            else
+                UpdateResistances(GetSpellSchoolByAuraGroup(UnitMods(i)));
+        }
+    }
+
+    if (mods & (1 << UNIT_MOD_HEALTH))
+        UpdateMaxHealth();
+
+    for (int i = UNIT_MOD_POWER_START; i < UNIT_MOD_POWER_END; ++i)
+        if (mods & (1 << i))
+            UpdateMaxPower(GetPowerTypeByAuraGroup(UnitMods(i)));
+
+    // weapon damage after attack power
+    if (mods & (1 << UNIT_MOD_ATTACK_POWER))
+        UpdateAttackPowerAndDamage();
+    if (mods & (1 << UNIT_MOD_ATTACK_POWER_RANGED))
+        UpdateAttackPowerAndDamage(true);
+
+    if (mods & (1 << UNIT_MOD_DAMAGE_MAINHAND))
+        UpdateDamagePhysical(BASE_ATTACK);
+    if (mods & (1 << UNIT_MOD_DAMAGE_OFFHAND))
+        UpdateDamagePhysical(OFF_ATTACK);
+    if (mods & (1 << UNIT_MOD_DAMAGE_RANGED))
+        UpdateDamagePhysical(RANGED_ATTACK);
+}
+
 float Unit::GetModifierValue(UnitMods unitMod, UnitModifierType modifierType) const
 {
     if( unitMod >= UNIT_MOD_END || modifierType >= MODIFIER_TYPE_END)
@@ -9185,6 +9286,9 @@ uint32 Unit::GetCreatePowers( Powers power ) const
 void Unit::AddToWorld()
 {
     Object::AddToWorld();
+
+    if (UnitSpatialIndex* index = GetMap()->GetUnitSpatialIndex())
+        index->Insert(this);
 }
 
 void Unit::RemoveFromWorld()
@@ -9199,6 +9303,14 @@ void Unit::RemoveFromWorld()
         RemoveAllDynObjects();
         CleanupDeletedAuras();
         GetViewPoint().Event_RemovedFromWorld();
+
+        if (UnitSpatialIndex* index = GetMap()->GetUnitSpatialIndex())
+            index->Remove(this);
+
+        // queued map notify skipped for not in world units
+        m_relocationNotify.queued = false;
+        m_relocationNotify.forced = false;
+        m_relocationNotify.pass = 0;
     }
 
     Object::RemoveFromWorld();
@@ -9491,6 +9603,47 @@ uint32 createProcExtendMask(SpellNonMeleeDamage *damageInfo, SpellMissInfo missC
     return procEx;
 }
 
+void Unit::AddHolderToProcIndex(SpellAuraHolder* holder)
+{
+    SpellEntry const* spellProto = holder->GetSpellProto();
+
+    // same as in IsTriggeredAtSpellProcEvent
+    SpellProcEventEntry const* spellProcEvent = sSpellMgr.GetSpellProcEvent(spellProto->Id);
+    uint32 procFlags = spellProcEvent && spellProcEvent->procFlags ? spellProcEvent->procFlags : spellProto->procFlags;
+    if (!procFlags)
+        return;
+
+    m_procHolders.insert(ProcHolderMap::value_type(holder->GetId(), ProcHolderEntry(holder, procFlags)));
+    m_procHoldersFlags |= procFlags;
+}
+
+void Unit::RemoveHolderFromProcIndex(SpellAuraHolder* holder)
+{
+    std::pair<ProcHolderMap::iterator, ProcHolderMap::iterator> bounds = m_procHolders.equal_range(holder->GetId());
+    for (ProcHolderMap::iterator itr = bounds.first; itr != bounds.second; ++itr)
+    {
+        if (itr->second.holder == holder)
+        {
+            m_procHolders.erase(itr);
+
+            m_procHoldersFlags = 0;
+            for (ProcHolderMap::const_iterator fItr = m_procHolders.begin(); fItr != m_procHolders.end(); ++fItr)
+                m_procHoldersFlags |= fItr->second.procFlags;
+            return;
+        }
+    }
+}
+
+void Unit::RebuildProcIndex()
+{
+    m_procHolders.clear();
+    m_procHoldersFlags = 0;
+    m_procHoldersVersion = sSpellMgr.GetSpellProcEventsVersion();
+
+    for (SpellAuraHolderMap::const_iterator itr = m_spellAuraHolders.begin(); itr != m_spellAuraHolders.end(); ++itr)
+        AddHolderToProcIndex(itr->second);
+}
+
 void Unit::ProcDamageAndSpellFor( bool isVictim, Unit * pTarget, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, SpellEntry const * procSpell, uint32 damage )
 {
     // For melee/ranged based attack need update skills and set some Aura states
@@ -9559,21 +9712,34 @@ void Unit::ProcDamageAndSpellFor( bool isVictim, Unit * pTarget, uint32 procFlag
         }
     }
 
+    // spell_proc_event reloaded
+    if (m_procHoldersVersion != sSpellMgr.GetSpellProcEventsVersion())
+        RebuildProcIndex();
+
+    // no holders that can be triggered by this event
+    if (!(m_procHoldersFlags & procFlag))
+        return;
+
     RemoveSpellList removedSpells;
     ProcTriggeredList procTriggered;
     // Fill procTriggered list
-    for(SpellAuraHolderMap::const_iterator itr = GetSpellAuraHolderMap().begin(); itr!= GetSpellAuraHolderMap().end(); ++itr)
+    for(ProcHolderMap::const_iterator itr = m_procHolders.begin(); itr != m_procHolders.end(); ++itr)
     {
+        if (!(itr->second.procFlags & procFlag))
+            continue;
+
+        SpellAuraHolder* holder = itr->second.holder;
+
         // skip deleted auras (possible at recursive triggered call
-        if(itr->second->IsDeleted())
+        if(holder->IsDeleted())
             continue;
 
         SpellProcEventEntry const* spellProcEvent = NULL;
-        if(!IsTriggeredAtSpellProcEvent(pTarget, itr->second, procSpell, procFlag, procExtra, attType, isVictim, spellProcEvent))
+        if(!IsTriggeredAtSpellProcEvent(pTarget, holder, procSpell, procFlag, procExtra, attType, isVictim, spellProcEvent))
            continue;
 
-        itr->second->SetInUse(true);                        // prevent holder deletion
-        procTriggered.push_back( ProcTriggeredData(spellProcEvent, itr->second) );
+        holder->SetInUse(true);                             // prevent holder deletion
+        procTriggered.push_back( ProcTriggeredData(spellProcEvent, holder) );
     }
 
     // Nothing found
@@ -9950,6 +10116,11 @@ void Unit::UpdateModelData()
             SetFloatValue(UNIT_FIELD_COMBATREACH, 1.5f);
         else
             SetFloatValue(UNIT_FIELD_COMBATREACH, GetObjectScale() * modelInfo->combat_reach);
+
+        // index keep bounding radius for distance filter
+        if (IsInWorld())
+            if (UnitSpatialIndex* index = GetMap()->GetUnitSpatialIndex())
+                index->Relocate(this);
     }
 }
 
@@ -10494,6 +10665,7 @@ void Unit::SendThreatUpdate()
         {
             data.appendPackGUID((*itr)->getUnitGuid());
             data << uint32((*itr)->getThreat());
+            (*itr)->setClientThreatSent();
         }
         SendMessageToSet(&data, false);
     }
@@ -10513,6 +10685,7 @@ void Unit::SendHighestThreatUpdate(HostileReference* pHostilReference)
         {
             data.appendPackGUID((*itr)->getUnitGuid());
             data << uint32((*itr)->getThreat());
+            (*itr)->setClientThreatSent();
         }
         SendMessageToSet(&data, false);
     }
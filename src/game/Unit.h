@@ -1101,6 +1101,33 @@ typedef std::set<uint64> GuardianPetList;
 #define REGEN_TIME_FULL     2000                            // For this time difference is computed regen value
 #define REGEN_TIME_PRECISE  500                             // Used in Spell::CheckPower for precise regeneration in spell cast time
 
+// Relocation notifiers state, see Map::ScheduleRelocationNotify
+struct RelocationNotifyState
+{
+    RelocationNotifyState() : queued(false), forced(false), x(0.0f), y(0.0f), z(0.0f), lastTime(0), pass(0) {}
+
+    bool queued;                                            // in map relocation notify queue
+    bool forced;                                            // notify at next pass independent from moved distance
+    float x, y, z;                                          // position at last processed notify
+    uint32 lastTime;                                        // time of last processed notify (getMSTime)
+    uint32 pass;                                            // last map notify pass when processed, used for pair de-duplication
+};
+
+// Cached results of aura modifier calculations for single aura type, see Unit::GetAuraTypeAggregates
+struct AuraTypeAggregates
+{
+    AuraTypeAggregates() : total(0), multiplier(1.0f), maxPositive(0), maxNegative(0) {}
+
+    int32 total;
+    float multiplier;
+    int32 maxPositive;
+    int32 maxNegative;
+
+    typedef std::map<int32, int32> MiscTotals;
+    MiscTotals totalByMiscValue;                            // filled at request
+    MiscTotals totalByMiscMask;                             // filled at request, key is uint32 mask
+};
+
 struct SpellProcEventEntry;                                 // used only privately
 
 class MANGOS_DLL_SPEC Unit : public WorldObject
@@ -1128,6 +1155,9 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
             return m_floatValues[UNIT_FIELD_BOUNDINGRADIUS];
         }
 
+        RelocationNotifyState& GetRelocationNotifyState() { return m_relocationNotify; }
+        RelocationNotifyState const& GetRelocationNotifyState() const { return m_relocationNotify; }
+
         DiminishingLevels GetDiminishing(DiminishingGroup  group);
         void IncrDiminishing(DiminishingGroup group);
         void ApplyDiminishingToDuration(DiminishingGroup  group, int32 &duration,Unit* caster, DiminishingLevels Level, int32 limitduration);
@@ -1627,6 +1657,9 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
         Powers GetPowerTypeByAuraGroup(UnitMods unitMod) const;
         bool CanModifyStats() const { return m_canModifyStats; }
         void SetCanModifyStats(bool modifyStats) { m_canModifyStats = modifyStats; }
+        // HandleStatModifier calls between Begin/End only mark UnitMods, values recalculated once at batch end
+        void BeginStatUpdateBatch() { ++m_statUpdateBatch; }
+        void EndStatUpdateBatch();
         virtual bool UpdateStats(Stats stat) = 0;
         virtual bool UpdateAllStats() = 0;
         virtual void UpdateResistances(uint32 school) = 0;
@@ -1720,6 +1753,9 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
         // misc have plain value but we check it fit to provided values mask (mask & (1 << (misc-1)))
         float GetTotalAuraMultiplierByMiscValueForMask(AuraType auratype, uint32 mask) const;
 
+        // must be called at any modifier amount change for aura in m_modAuras list
+        void InvalidateAuraAggregates(AuraType auratype) { m_auraAggregates.erase(auratype); }
+
         Aura* GetDummyAura(uint32 spell_id) const;
 
         uint32 m_AuraFlags;
@@ -1773,6 +1809,11 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
         uint32 SpellCriticalHealingBonus(SpellEntry const *spellProto, uint32 damage, Unit *pVictim);
 
         bool IsTriggeredAtSpellProcEvent(Unit *pVictim, SpellAuraHolder* holder, SpellEntry const* procSpell, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool isVictim, SpellProcEventEntry const*& spellProcEvent );
+
+        // index of holders that can proc, see m_procHolders
+        void AddHolderToProcIndex(SpellAuraHolder* holder);
+        void RemoveHolderFromProcIndex(SpellAuraHolder* holder);
+        void RebuildProcIndex();
         // Aura proc handlers
         SpellAuraProcResult HandleDummyAuraProc(Unit *pVictim, uint32 damage, Aura* triggeredByAura, SpellEntry const *procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown);
         SpellAuraProcResult HandleHasteAuraProc(Unit *pVictim, uint32 damage, Aura* triggeredByAura, SpellEntry const *procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown);
@@ -1906,6 +1947,18 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
         SpellAuraHolderMap m_spellAuraHolders;
         SpellAuraHolderMap::iterator m_spellAuraHoldersUpdateIterator; // != end() in Unit::m_spellAuraHolders update and point to next element
         AuraList m_deletedAuras;                                       // auras removed while in ApplyModifier and waiting deleted
+
+        struct ProcHolderEntry
+        {
+            ProcHolderEntry(SpellAuraHolder* _holder, uint32 _procFlags) : holder(_holder), procFlags(_procFlags) {}
+
+            SpellAuraHolder* holder;
+            uint32 procFlags;                                          // spell_proc_event or spell proc flags
+        };
+        typedef std::multimap<uint32, ProcHolderEntry> ProcHolderMap;
+        ProcHolderMap m_procHolders;                                   // holders with proc flags, same order as in m_spellAuraHolders
+        uint32 m_procHoldersFlags;                                     // all m_procHolders proc flags
+        uint32 m_procHoldersVersion;                                   // SpellMgr::GetSpellProcEventsVersion at index build
         SpellAuraHolderList m_deletedHolders;
 
         SpellAuraHolderList m_scSpellAuraHolders;                      // casted by unit single per-caster auras
@@ -1919,9 +1972,14 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
         uint32 m_transform;
 
         AuraList m_modAuras[TOTAL_AURAS];
+        typedef UNORDERED_MAP<uint32, AuraTypeAggregates> AuraAggregatesMap;
+        mutable AuraAggregatesMap m_auraAggregates;                    // only for aura types with applied auras
+        AuraTypeAggregates& GetAuraTypeAggregates(AuraType auratype) const;
         float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
         float m_weaponDamage[MAX_ATTACK][2];
         bool m_canModifyStats;
+        uint32 m_statUpdateBatch;                           // nested stat update batches count
+        uint32 m_deferredStatMods;                          // (1 << UnitMods) mask of changed in batch modifiers
         //std::list< spellEffectPair > AuraSpells[TOTAL_AURAS];  // TODO: use this if ok for mem
         VisibleAuraMap m_visibleAuras;
 
@@ -1968,6 +2026,8 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
         GuardianPetList m_guardianPets;
 
         uint64 m_TotemSlot[MAX_TOTEM_SLOT];
+
+        RelocationNotifyState m_relocationNotify;
 };
 
 template<typename Func>
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2005-2010 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "UnitSpatialIndex.h"
+#include "Unit.h"
+#include "GridDefines.h"
+
+UnitSpatialIndex::UnitSpatialIndex(float cellSize) : m_cellSize(std::max(cellSize, UNIT_INDEX_MIN_CELL_SIZE)), m_maxBoundingRadius(0.0f)
+{
+}
+
+uint32 UnitSpatialIndex::ToCellCoord(float c) const
+{
+    float const coord = (c + MAP_HALFSIZE) / m_cellSize;
+    if (coord <= 0.0f)
+        return 0;
+    if (coord >= float(0xFFFF))
+        return 0xFFFF;
+    return uint32(coord);
+}
+
+bool UnitSpatialIndex::CanReplaceCellSearch(CellPair const& standingCell, float x, float y, float radius) const
+{
+    if (radius <= 0.0f || radius * 2.0f > m_cellSize * UNIT_INDEX_MAX_QUERY_CELLS)
+        return false;
+
+    // bounds of grid cell, inverse of MaNGOS::ComputeCellPair
+    double const minX = (double(standingCell.x_coord) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+    double const minY = (double(standingCell.y_coord) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+    double const range = radius + m_maxBoundingRadius;
+
+    return x - range >= minX && x + range < minX + SIZE_OF_GRID_CELL &&
+        y - range >= minY && y + range < minY + SIZE_OF_GRID_CELL;
+}
+
+void UnitSpatialIndex::Insert(Unit* unit)
+{
+    UnitSlotMap::iterator itr = m_slots.find(unit);
+    if (itr != m_slots.end())
+    {
+        Relocate(unit);
+        return;
+    }
+
+    UnitSlot& slot = m_slots[unit];
+    slot.radius = unit->GetObjectBoundingRadius();
+    AddRadius(slot.radius);
+    AddToCell(unit, MakeCellKey(ToCellCoord(unit->GetPositionX()), ToCellCoord(unit->GetPositionY())), slot);
+}
+
+void UnitSpatialIndex::Remove(Unit* unit)
+{
+    UnitSlotMap::iterator itr = m_slots.find(unit);
+    if (itr == m_slots.end())
+        return;
+
+    RemoveFromCell(itr->second);
+    RemoveRadius(itr->second.radius);
+    m_slots.erase(itr);
+}
+
+void UnitSpatialIndex::Relocate(Unit* unit)
+{
+    UnitSlotMap::iterator itr = m_slots.find(unit);
+    if (itr == m_slots.end())
+        return;
+
+    UnitSlot& slot = itr->second;
+
+    float radius = unit->GetObjectBoundingRadius();
+    if (radius != slot.radius)
+    {
+        RemoveRadius(slot.radius);
+        AddRadius(radius);
+        slot.radius = radius;
+    }
+
+    uint32 cellKey = MakeCellKey(ToCellCoord(unit->GetPositionX()), ToCellCoord(unit->GetPositionY()));
+
+    if (cellKey != slot.cellKey)
+    {
+        RemoveFromCell(slot);
+        AddToCell(unit, cellKey, slot);
+        return;
+    }
+
+    IndexCell& cell = m_cells[slot.cellKey];
+    cell.posX[slot.index] = unit->GetPositionX();
+    cell.posY[slot.index] = unit->GetPositionY();
+    cell.radius[slot.index] = radius;
+}
+
+void UnitSpatialIndex::AddToCell(Unit* unit, uint32 cellKey, UnitSlot& slot)
+{
+    IndexCell& cell = m_cells[cellKey];
+
+    slot.cellKey = cellKey;
+    slot.index = uint32(cell.units.size());
+
+    cell.units.push_back(unit);
+    cell.posX.push_back(unit->GetPositionX());
+    cell.posY.push_back(unit->GetPositionY());
+    cell.radius.push_back(slot.radius);
+}
+
+void UnitSpatialIndex::RemoveFromCell(UnitSlot const& slot)
+{
+    IndexCell& cell = m_cells[slot.cellKey];
+    uint32 last = uint32(cell.units.size()) - 1;
+
+    // move last unit in cell to free place
+    if (slot.index != last)
+    {
+        cell.units[slot.index] = cell.units[last];
+        cell.posX[slot.index] = cell.posX[last];
+        cell.posY[slot.index] = cell.posY[last];
+        cell.radius[slot.index] = cell.radius[last];
+        m_slots[cell.units[slot.index]].index = slot.index;
+    }
+
+    cell.units.pop_back();
+    cell.posX.pop_back();
+    cell.posY.pop_back();
+    cell.radius.pop_back();
+
+    // not keep empty cells, units move over all map
+    if (cell.units.empty())
+        m_cells.erase(slot.cellKey);
+}
+
+void UnitSpatialIndex::AddRadius(float radius)
+{
+    ++m_radiusCounts[radius];
+
+    if (radius > m_maxBoundingRadius)
+        m_maxBoundingRadius = radius;
+}
+
+void UnitSpatialIndex::RemoveRadius(float radius)
+{
+    RadiusCountMap::iterator itr = m_radiusCounts.find(radius);
+    if (itr == m_radiusCounts.end())
+        return;
+
+    if (--itr->second == 0)
+    {
+        m_radiusCounts.erase(itr);
+        m_maxBoundingRadius = m_radiusCounts.empty() ? 0.0f : m_radiusCounts.rbegin()->first;
+    }
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2005-2010 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_UNITSPATIALINDEX_H
+#define MANGOS_UNITSPATIALINDEX_H
+
+#include "Common.h"
+#include "Utilities/UnorderedMapSet.h"
+#include "GridDefines.h"
+
+class Unit;
+
+#define UNIT_INDEX_MIN_CELL_SIZE      2.0f
+#define UNIT_INDEX_MAX_QUERY_CELLS    4                     // max index cells per axis for query, larger searches faster by grid cells
+#define UNIT_INDEX_FILTER_BATCH       64
+
+/**
+ * Per-map uniform hash of players and creatures in world, independent from grid cells.
+ *
+ * Grid cells are ~66 yards, so small radius searches in crowded places test many far objects.
+ * This index uses small cells (SpatialIndex.CellSize) and keeps unit positions in plain
+ * float arrays per cell, so distance prefilter is a tight loop over continuous memory
+ * that the compiler can vectorize. Searchers still do their own exact checks.
+ *
+ * Units are added/removed at Unit::AddToWorld/RemoveFromWorld and moved at any WorldObject::Relocate
+ * (so at Map::PlayerRelocation/CreatureRelocation too), bounding radius updated at Unit::UpdateModelData.
+ * Queries use the area of the searcher's own check (see GetUnitCheckArea in GridNotifiers.h and
+ * Spell::FillAreaTargets), and only when that area is inside the standing grid cell of the search,
+ * so index and grid visit find same units. Other searches still use grid cells visit.
+ */
+class MANGOS_DLL_SPEC UnitSpatialIndex
+{
+    public:
+        explicit UnitSpatialIndex(float cellSize);
+
+        void Insert(Unit* unit);
+        void Remove(Unit* unit);
+        void Relocate(Unit* unit);
+
+        // true if query by (x,y,radius) finds same units as grid cells visit with this standing cell
+        // (query area extended by max unit bounding radius is inside that always visited cell) and is cheaper than it
+        bool CanReplaceCellSearch(CellPair const& standingCell, float x, float y, float radius) const;
+
+        // call visitor.VisitUnit(Unit*) for units in 2d radius (+unit bounding radius) of (x,y), visitor must not relocate units
+        template<class VISITOR>
+        void VisitUnitsInRange(float x, float y, float radius, VISITOR& visitor) const;
+
+        uint32 GetUnitsCount() const { return uint32(m_slots.size()); }
+        float GetCellSize() const { return m_cellSize; }
+
+    private:
+        struct IndexCell
+        {
+            std::vector<Unit*> units;
+            std::vector<float> posX;
+            std::vector<float> posY;
+            std::vector<float> radius;
+        };
+
+        struct UnitSlot
+        {
+            uint32 cellKey;
+            uint32 index;
+            float radius;
+        };
+
+        typedef UNORDERED_MAP<uint32, IndexCell> IndexCellMap;
+        typedef UNORDERED_MAP<Unit const*, UnitSlot> UnitSlotMap;
+        typedef std::map<float, uint32> RadiusCountMap;
+
+        uint32 ToCellCoord(float c) const;
+        static uint32 MakeCellKey(uint32 x, uint32 y) { return (x << 16) | y; }
+
+        void AddToCell(Unit* unit, uint32 cellKey, UnitSlot& slot);
+        void RemoveFromCell(UnitSlot const& slot);
+
+        void AddRadius(float radius);
+        void RemoveRadius(float radius);
+
+        float m_cellSize;
+        float m_maxBoundingRadius;                          // max radius of indexed units, used for extend query cells range
+        IndexCellMap m_cells;
+        UnitSlotMap m_slots;
+        RadiusCountMap m_radiusCounts;                      // indexed units count by bounding radius
+};
+
+template<class VISITOR>
+void UnitSpatialIndex::VisitUnitsInRange(float x, float y, float radius, VISITOR& visitor) const
+{
+    float const range = radius + m_maxBoundingRadius;
+    uint32 const beginX = ToCellCoord(x - range);
+    uint32 const endX   = ToCellCoord(x + range);
+    uint32 const beginY = ToCellCoord(y - range);
+    uint32 const endY   = ToCellCoord(y + range);
+
+    bool inRange[UNIT_INDEX_FILTER_BATCH];
+
+    for (uint32 cx = beginX; cx <= endX; ++cx)
+    {
+        for (uint32 cy = beginY; cy <= endY; ++cy)
+        {
+            IndexCellMap::const_iterator itr = m_cells.find(MakeCellKey(cx, cy));
+            if (itr == m_cells.end())
+                continue;
+
+            IndexCell const& cell = itr->second;
+            uint32 const count = uint32(cell.units.size());
+
+            for (uint32 base = 0; base < count; base += UNIT_INDEX_FILTER_BATCH)
+            {
+                uint32 const batch = std::min(count - base, uint32(UNIT_INDEX_FILTER_BATCH));
+                float const* px = &cell.posX[base];
+                float const* py = &cell.posY[base];
+                float const* pr = &cell.radius[base];
+
+                // branch free distance filter
+                for (uint32 i = 0; i < batch; ++i)
+                {
+                    float const dx = px[i] - x;
+                    float const dy = py[i] - y;
+                    float const dist = radius + pr[i];
+                    inRange[i] = dx*dx + dy*dy <= dist*dist;
+                }
+
+                for (uint32 i = 0; i < batch; ++i)
+                    if (inRange[i])
+                        visitor.VisitUnit(cell.units[base + i]);
+            }
+        }
+    }
+}
+
+#endif
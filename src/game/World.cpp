@@ -40,6 +40,8 @@
 #include "ObjectMgr.h"
 #include "CreatureEventAIMgr.h"
 #include "SpellMgr.h"
+#include "Spell.h"
+#include "SpellAuras.h"
 #include "Chat.h"
 #include "DBCStores.h"
 #include "LootMgr.h"
@@ -511,6 +513,7 @@ void World::LoadConfigSettings(bool reload)
 
     setConfigPos(CONFIG_FLOAT_CREATURE_FAMILY_ASSISTANCE_RADIUS,      "CreatureFamilyAssistanceRadius",     10.0f);
     setConfigPos(CONFIG_FLOAT_CREATURE_FAMILY_FLEE_ASSISTANCE_RADIUS, "CreatureFamilyFleeAssistanceRadius", 30.0f);
+    setConfig(CONFIG_BOOL_CREATURE_DORMANT_OUT_OF_SIGHT, "CreatureDormantOutOfSight", false);
 
     ///- Read other configuration items from the config file
     setConfigMinMax(CONFIG_UINT32_COMPRESSION, "Compression", 1, 1, 9);
@@ -652,6 +655,12 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_BOOL_SAVE_RESPAWN_TIME_IMMEDIATLY, "SaveRespawnTimeImmediately", true);
+    setConfig(CONFIG_UINT32_INTERVAL_RESPAWN_SAVE, "SaveRespawnTimeInterval", 5 * IN_MILLISECONDS);
+    if (reload)
+    {
+        m_timers[WUPDATE_RESPAWNSAVE].SetInterval(getConfig(CONFIG_UINT32_INTERVAL_RESPAWN_SAVE));
+        m_timers[WUPDATE_RESPAWNSAVE].Reset();
+    }
     setConfig(CONFIG_BOOL_WEATHER, "ActivateWeather", true);
 
     setConfig(CONFIG_BOOL_ALWAYS_MAX_SKILL_FOR_LEVEL, "AlwaysMaxSkillForLevel", false);
@@ -686,6 +695,16 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_BOOL_DETECT_POS_COLLISION, "DetectPosCollision", true);
 
+    setConfig(CONFIG_BOOL_PATHFINDING_ENABLED, "PathFinding.Enable", false);
+    setConfig(CONFIG_UINT32_PATHFINDING_MAX_NODES_PER_TICK, "PathFinding.MaxNodesPerTick", 4096);
+
+    setConfigPos(CONFIG_FLOAT_SPATIAL_INDEX_CELL_SIZE, "SpatialIndex.CellSize", 0.0f);
+    if (getConfig(CONFIG_FLOAT_SPATIAL_INDEX_CELL_SIZE) > SIZE_OF_GRID_CELL)
+    {
+        sLog.outError("SpatialIndex.CellSize (%f) must be <= %f. Using %f instead.", getConfig(CONFIG_FLOAT_SPATIAL_INDEX_CELL_SIZE), SIZE_OF_GRID_CELL, SIZE_OF_GRID_CELL);
+        setConfig(CONFIG_FLOAT_SPATIAL_INDEX_CELL_SIZE, SIZE_OF_GRID_CELL);
+    }
+
     setConfig(CONFIG_BOOL_RESTRICTED_LFG_CHANNEL,      "Channel.RestrictedLfg", true);
     setConfig(CONFIG_BOOL_SILENTLY_GM_JOIN_TO_CHANNEL, "Channel.SilentlyGMJoin", false);
 
@@ -832,6 +851,19 @@ void World::LoadConfigSettings(bool reload)
         m_MaxVisibleDistanceInFlight = MAX_VISIBILITY_DISTANCE - m_VisibleObjectGreyDistance;
     }
 
+    setConfigPos(CONFIG_FLOAT_RELOCATION_LOWER_LIMIT, "Visibility.RelocationLowerLimit", 2.0f);
+    setConfig(CONFIG_UINT32_RELOCATION_NOTIFY_DELAY, "Visibility.AIRelocationNotifyDelay", 1000);
+    setConfig(CONFIG_UINT32_VISIBILITY_UPDATE_INTERVAL, "Visibility.UpdateInterval", 200);
+    setConfig(CONFIG_UINT32_VISIBILITY_LOD_MID_INTERVAL, "Visibility.LOD.MidInterval", 1000);
+    setConfig(CONFIG_UINT32_VISIBILITY_LOD_EDGE_INTERVAL, "Visibility.LOD.EdgeInterval", 5000);
+    LoadMapVisibilityLOD();
+
+    setConfig(CONFIG_UINT32_VISIBILITY_CROWD_THRESHOLD, "Visibility.Crowd.Threshold", 0);
+    setConfigMin(CONFIG_UINT32_VISIBILITY_CROWD_UPDATE_INTERVAL, "Visibility.Crowd.UpdateInterval", 5000, 1000);
+    setConfigMinMax(CONFIG_FLOAT_VISIBILITY_CROWD_MIN_DISTANCE, "Visibility.Crowd.MinDistance", 40.0f, INTERACTION_DISTANCE, MAX_VISIBILITY_DISTANCE);
+    setConfigMinMax(CONFIG_FLOAT_VISIBILITY_CROWD_MAX_DISTANCE, "Visibility.Crowd.MaxDistance", 0.0f, 0.0f, MAX_VISIBILITY_DISTANCE);
+    setConfigPos(CONFIG_FLOAT_VISIBILITY_CROWD_HYSTERESIS, "Visibility.Crowd.Hysteresis", 10.0f);
+
     ///- Load the CharDelete related config options
     setConfigMinMax(CONFIG_UINT32_CHARDELETE_METHOD, "CharDelete.Method", 0, 0, 1);
     setConfigMinMax(CONFIG_UINT32_CHARDELETE_MIN_LEVEL, "CharDelete.MinLevel", 0, 0, getConfig(CONFIG_UINT32_MAX_PLAYER_LEVEL));
@@ -867,6 +899,36 @@ void World::LoadConfigSettings(bool reload)
     sLog.outString( "WORLD: VMap config keys are: vmap.enableLOS, vmap.enableHeight, vmap.ignoreMapIds, vmap.ignoreSpellIds");
 }
 
+/// Parse Visibility.LOD.Maps: list of "mapId:nearDistance:midDistance" separated by commas
+void World::LoadMapVisibilityLOD()
+{
+    m_mapVisibilityLOD.clear();
+
+    Tokens entries = StrSplit(sConfig.GetStringDefault("Visibility.LOD.Maps", ""), ",");
+    for(Tokens::const_iterator itr = entries.begin(); itr != entries.end(); ++itr)
+    {
+        Tokens values = StrSplit(*itr, ":");
+        if (values.size() != 3)
+        {
+            sLog.outError("Visibility.LOD.Maps: wrong entry '%s', must be mapId:nearDistance:midDistance", itr->c_str());
+            continue;
+        }
+
+        uint32 mapId = uint32(atoi(values[0].c_str()));
+        MapVisibilityLOD lod;
+        lod.nearDistance = float(atof(values[1].c_str()));
+        lod.midDistance = float(atof(values[2].c_str()));
+
+        if (lod.nearDistance < INTERACTION_DISTANCE || lod.midDistance < lod.nearDistance)
+        {
+            sLog.outError("Visibility.LOD.Maps: wrong distances for map %u, must be %f <= nearDistance <= midDistance", mapId, INTERACTION_DISTANCE);
+            continue;
+        }
+
+        m_mapVisibilityLOD[mapId] = lod;
+    }
+}
+
 /// Initialize the World
 void World::SetInitialWorldSettings()
 {
@@ -986,6 +1048,9 @@ void World::SetInitialWorldSettings()
     sLog.outString( "Loading Aggro Spells Definitions...");
     sSpellMgr.LoadSpellThreats();
 
+    sLog.outString( "Precomputing Spell Data..." );
+    sSpellMgr.LoadSpellInfoTable();                         // must be after LoadSpellChains and LoadSpellElixirs
+
     sLog.outString( "Loading NPC Texts..." );
     sObjectMgr.LoadGossipText();
 
@@ -1156,6 +1221,9 @@ void World::SetInitialWorldSettings()
     sLog.outString();
 
     ///- Load dynamic data tables from the database
+    sLog.outString( "Loading Character names..." );
+    sObjectMgr.LoadCharacterNameData();
+
     sLog.outString( "Loading Auctions..." );
     sLog.outString();
     sAuctionMgr.LoadAuctionItems();
@@ -1273,6 +1341,7 @@ void World::SetInitialWorldSettings()
                                                             //Update "uptime" table based on configuration entry in minutes.
     m_timers[WUPDATE_CORPSES].SetInterval(3*HOUR*IN_MILLISECONDS);
     m_timers[WUPDATE_DELETECHARS].SetInterval(DAY*IN_MILLISECONDS); // check for chars to delete every day
+    m_timers[WUPDATE_RESPAWNSAVE].SetInterval(m_configUint32Values[CONFIG_UINT32_INTERVAL_RESPAWN_SAVE]);
 
     //to set mailtimer to return mails every day between 4 and 5 am
     //mailtimer is increased when updating auctions
@@ -1381,6 +1450,11 @@ void World::Update(uint32 diff)
             m_timers[i].SetCurrent(0);
     }
 
+    ///- Start new tick for pooled spell objects allocation counters
+    Spell::NextPoolTick();
+    SpellAuraHolder::NextPoolTick();
+    Aura::NextPoolTick();
+
     ///- Update the game time and check for shutdown time
     _UpdateGameTime();
 
@@ -1465,6 +1539,13 @@ void World::Update(uint32 diff)
         Player::DeleteOldCharacters();
     }
 
+    ///- Save respawn times changed since last save in one transaction
+    if (m_timers[WUPDATE_RESPAWNSAVE].Passed())
+    {
+        m_timers[WUPDATE_RESPAWNSAVE].Reset();
+        sObjectMgr.SavePendingRespawnTimes();
+    }
+
     // execute callbacks from sql queries that were queued recently
     UpdateResultQueue();
 
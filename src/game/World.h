@@ -78,7 +78,8 @@ enum WorldTimers
     WUPDATE_CORPSES     = 5,
     WUPDATE_EVENTS      = 6,
     WUPDATE_DELETECHARS = 7,
-    WUPDATE_COUNT       = 8
+    WUPDATE_RESPAWNSAVE = 8,
+    WUPDATE_COUNT       = 9
 };
 
 /// Configuration elements
@@ -89,6 +90,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
     CONFIG_UINT32_INTERVAL_CHANGEWEATHER,
+    CONFIG_UINT32_INTERVAL_RESPAWN_SAVE,
     CONFIG_UINT32_PORT_WORLD,
     CONFIG_UINT32_SOCKET_SELECTTIME,
     CONFIG_UINT32_GAME_TYPE,
@@ -182,6 +184,13 @@ enum eConfigUInt32Values
     CONFIG_UINT32_CHARDELETE_KEEP_DAYS,
     CONFIG_UINT32_CHARDELETE_METHOD,
     CONFIG_UINT32_CHARDELETE_MIN_LEVEL,
+    CONFIG_UINT32_RELOCATION_NOTIFY_DELAY,
+    CONFIG_UINT32_VISIBILITY_UPDATE_INTERVAL,
+    CONFIG_UINT32_VISIBILITY_LOD_MID_INTERVAL,
+    CONFIG_UINT32_VISIBILITY_LOD_EDGE_INTERVAL,
+    CONFIG_UINT32_VISIBILITY_CROWD_THRESHOLD,
+    CONFIG_UINT32_VISIBILITY_CROWD_UPDATE_INTERVAL,
+    CONFIG_UINT32_PATHFINDING_MAX_NODES_PER_TICK,
     CONFIG_UINT32_VALUE_COUNT
 };
 
@@ -264,6 +273,11 @@ enum eConfigFloatValues
     CONFIG_FLOAT_CREATURE_FAMILY_ASSISTANCE_RADIUS,
     CONFIG_FLOAT_GROUP_XP_DISTANCE,
     CONFIG_FLOAT_THREAT_RADIUS,
+    CONFIG_FLOAT_SPATIAL_INDEX_CELL_SIZE,
+    CONFIG_FLOAT_RELOCATION_LOWER_LIMIT,
+    CONFIG_FLOAT_VISIBILITY_CROWD_MIN_DISTANCE,
+    CONFIG_FLOAT_VISIBILITY_CROWD_MAX_DISTANCE,
+    CONFIG_FLOAT_VISIBILITY_CROWD_HYSTERESIS,
     CONFIG_FLOAT_VALUE_COUNT
 };
 
@@ -319,6 +333,8 @@ enum eConfigBoolValues
     CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT,
     CONFIG_BOOL_CLEAN_CHARACTER_DB,
     CONFIG_BOOL_VMAP_INDOOR_CHECK,
+    CONFIG_BOOL_PATHFINDING_ENABLED,
+    CONFIG_BOOL_CREATURE_DORMANT_OUT_OF_SIGHT,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -442,6 +458,15 @@ struct CliCommandHolder
     ~CliCommandHolder() { delete[] m_command; }
 };
 
+/// Visibility level of detail distances for map, from Visibility.LOD.Maps
+struct MapVisibilityLOD
+{
+    float nearDistance;                                     // full rate client updates
+    float midDistance;                                      // reduced rate client updates, only create/destroy at larger distance
+};
+
+typedef std::map<uint32, MapVisibilityLOD> MapVisibilityLODMap;
+
 /// The World
 class World
 {
@@ -582,6 +607,12 @@ class World
         static float GetVisibleUnitGreyDistance()           { return m_VisibleUnitGreyDistance;       }
         static float GetVisibleObjectGreyDistance()         { return m_VisibleObjectGreyDistance;     }
 
+        MapVisibilityLOD const* GetMapVisibilityLOD(uint32 mapId) const
+        {
+            MapVisibilityLODMap::const_iterator itr = m_mapVisibilityLOD.find(mapId);
+            return itr != m_mapVisibilityLOD.end() ? &itr->second : NULL;
+        }
+
         void ProcessCliCommands();
         void QueueCliCommand(CliCommandHolder* commandHolder) { cliCmdQueue.add(commandHolder); }
 
@@ -673,6 +704,9 @@ class World
         static float m_VisibleUnitGreyDistance;
         static float m_VisibleObjectGreyDistance;
 
+        void LoadMapVisibilityLOD();
+        MapVisibilityLODMap m_mapVisibilityLOD;
+
         // CLI command holder to be thread safe
         ACE_Based::LockedQueue<CliCommandHolder*,ACE_Thread_Mutex> cliCmdQueue;
         SqlResultQueue *m_resultQueue;
@@ -45,7 +45,7 @@ LookingForGroup_auto_join(false), LookingForGroup_auto_add(false), m_muteTime(mu
 _player(NULL), m_Socket(sock),_security(sec), _accountId(id), m_expansion(expansion),
 m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetIndexForLocale(locale)),
 _logoutTime(0), m_inQueue(false), m_playerLoading(false), m_playerLogout(false), m_playerRecentlyLogout(false), m_playerSave(false),
-m_latency(0), m_tutorialState(TUTORIALDATA_UNCHANGED)
+m_latency(0), m_sentBytes(0), m_sentBytesTimer(0), m_sentBytesPerSecond(0), m_tutorialState(TUTORIALDATA_UNCHANGED)
 {
     if (sock)
     {
@@ -129,6 +129,8 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
     #endif                                                  // !MANGOS_DEBUG
 
+    m_sentBytes += packet->size();
+
     if (m_Socket->SendPacket (*packet) == -1)
         m_Socket->CloseSocket ();
 }
@@ -158,8 +160,16 @@ void WorldSession::LogUnprocessedTail(WorldPacket *packet)
 }
 
 /// Update the WorldSession (triggered by World update)
-bool WorldSession::Update(uint32 /*diff*/)
+bool WorldSession::Update(uint32 diff)
 {
+    m_sentBytesTimer += diff;
+    if (m_sentBytesTimer >= IN_MILLISECONDS)
+    {
+        m_sentBytesPerSecond = uint32(uint64(m_sentBytes) * IN_MILLISECONDS / m_sentBytesTimer);
+        m_sentBytes = 0;
+        m_sentBytesTimer = 0;
+    }
+
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not proccess packets if socket already closed
     WorldPacket* packet;
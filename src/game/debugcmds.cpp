@@ -32,6 +32,10 @@
 #include "ObjectMgr.h"
 #include "ObjectGuid.h"
 #include "SpellMgr.h"
+#include "Spell.h"
+#include "SpellAuras.h"
+#include "World.h"
+#include "QueryResponseCache.h"
 
 bool ChatHandler::HandleDebugSendSpellFailCommand(char* args)
 {
@@ -1086,3 +1090,121 @@ bool ChatHandler::HandleDebugSpellModsCommand(char* args)
 
     return true;
 }
+
+bool ChatHandler::HandleDebugVisibilityCommand(char* /*args*/)
+{
+    Player* player = m_session->GetPlayer();
+    Map* map = player->GetMap();
+
+    PSendSysMessage("Map %u (instance %u): visibility distance %.1f, players %u",
+        map->GetId(), map->GetInstanceId(), map->GetVisibilityDistance(), map->GetPlayersCountExceptGMs());
+    PSendSysMessage("Last map update: visibility updates %u, visibility checks %u",
+        map->GetLastTickVisibilityUpdates(), map->GetLastTickVisibilityChecks());
+
+    if (sWorld.getConfig(CONFIG_BOOL_CREATURE_DORMANT_OUT_OF_SIGHT))
+        PSendSysMessage("Dormant creatures skipped in last map update %u", map->GetLastTickDormantSkips());
+    PSendSysMessage("Your client has %u visible objects", uint32(player->m_clientGUIDs.size()));
+
+    if (map->HasVisibilityLOD())
+        PSendSysMessage("Visibility LOD: near %.1f, mid %.1f, mid update interval %u ms, edge update interval %u ms",
+            map->GetVisibilityLODDistance(VISIBILITY_LOD_NEAR), map->GetVisibilityLODDistance(VISIBILITY_LOD_MID),
+            sWorld.getConfig(CONFIG_UINT32_VISIBILITY_LOD_MID_INTERVAL), sWorld.getConfig(CONFIG_UINT32_VISIBILITY_LOD_EDGE_INTERVAL));
+
+    uint32 totalBytes = 0;
+    uint32 sessions = 0;
+    Map::PlayerList const& players = map->GetPlayers();
+    for (Map::PlayerList::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+    {
+        if (WorldSession* session = itr->getSource()->GetSession())
+        {
+            totalBytes += session->GetSentBytesPerSecond();
+            ++sessions;
+        }
+    }
+
+    PSendSysMessage("Outgoing traffic: yours %u bytes/s, map average %u bytes/s per player",
+        m_session->GetSentBytesPerSecond(), sessions ? totalBytes / sessions : 0);
+    return true;
+}
+
+bool ChatHandler::HandleDebugPathFinderCommand(char* /*args*/)
+{
+    Map* map = m_session->GetPlayer()->GetMap();
+    PathFinder const& pathFinder = map->GetPathFinder();
+
+    PSendSysMessage("Map %u (instance %u): pathfinding %s, cached paths %u, hits %u, misses %u, cached node heights %u",
+        map->GetId(), map->GetInstanceId(), sWorld.getConfig(CONFIG_BOOL_PATHFINDING_ENABLED) ? "enabled" : "disabled",
+        pathFinder.GetCacheSize(), pathFinder.GetCacheHits(), pathFinder.GetCacheMisses(), pathFinder.GetHeightCacheSize());
+    PSendSysMessage("Searched nodes in last map update %u (limit %u), direct paths by limit %u",
+        pathFinder.GetLastTickNodes(), sWorld.getConfig(CONFIG_UINT32_PATHFINDING_MAX_NODES_PER_TICK), pathFinder.GetBudgetFallbacks());
+    return true;
+}
+
+struct ZoneVisibility
+{
+    ZoneVisibility() : players(0), minDist(0.0f), maxDist(0.0f) {}
+
+    uint32 players;
+    float minDist;
+    float maxDist;
+};
+
+bool ChatHandler::HandleDebugVisibilityZonesCommand(char* /*args*/)
+{
+    Map* map = m_session->GetPlayer()->GetMap();
+
+    typedef std::map<uint32, ZoneVisibility> ZoneVisibilityMap;
+    ZoneVisibilityMap zones;
+
+    Map::PlayerList const& players = map->GetPlayers();
+    for (Map::PlayerList::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+    {
+        Player* plr = itr->getSource();
+        float dist = map->GetVisibilityDistance(plr->GetCamera().GetBody());
+
+        ZoneVisibility& zone = zones[plr->GetZoneId()];
+        zone.minDist = zone.players ? std::min(zone.minDist, dist) : dist;
+        zone.maxDist = zone.players ? std::max(zone.maxDist, dist) : dist;
+        ++zone.players;
+    }
+
+    PSendSysMessage("Map %u (instance %u): visibility distance %.1f, crowd reduced: %s",
+        map->GetId(), map->GetInstanceId(), map->GetVisibilityDistance(), map->HasCrowdedRegions() ? "yes" : "no");
+
+    for (ZoneVisibilityMap::const_iterator itr = zones.begin(); itr != zones.end(); ++itr)
+    {
+        AreaTableEntry const* zoneEntry = GetAreaEntryByAreaID(itr->first);
+        PSendSysMessage("Zone %u (%s): players %u, effective visibility distance %.1f - %.1f",
+            itr->first, zoneEntry ? zoneEntry->area_name[GetSessionDbcLocale()] : "<unknown>",
+            itr->second.players, itr->second.minDist, itr->second.maxDist);
+    }
+
+    return true;
+}
+
+static void SendPoolStats(ChatHandler* handler, char const* name, MaNGOS::PoolAllocationStats const& stats)
+{
+    handler->PSendSysMessage("%s: in use %u, free %u, chunks %u, last tick allocations %u (from heap %u)",
+        name, stats.inUse, stats.freeCount, stats.chunks, stats.lastTickAllocs, stats.lastTickHeapAllocs);
+}
+
+bool ChatHandler::HandleDebugPoolsCommand(char* /*args*/)
+{
+    SendPoolStats(this, "Spell", Spell::GetPoolStats());
+    SendPoolStats(this, "SpellAuraHolder", SpellAuraHolder::GetPoolStats());
+    SendPoolStats(this, "Aura", Aura::GetPoolStats());
+    return true;
+}
+
+bool ChatHandler::HandleDebugQueryCacheCommand(char* /*args*/)
+{
+    static char const* typeNames[MAX_QUERY_CACHE_TYPE] = { "creature", "gameobject", "item", "quest", "npc text", "page text" };
+
+    for (int i = 0; i < MAX_QUERY_CACHE_TYPE; ++i)
+    {
+        QueryCacheType type = QueryCacheType(i);
+        PSendSysMessage("%s: cached responses %u, hits %u, misses %u", typeNames[i],
+            uint32(sQueryResponseCache.GetSize(type)), sQueryResponseCache.GetHits(type), sQueryResponseCache.GetMisses(type));
+    }
+    return true;
+}
@@ -278,6 +278,16 @@ void ChatHandler::HandleCharacterDeletedRestoreHelper(DeletedInfo const& delInfo
 
     CharacterDatabase.PExecute("UPDATE characters SET name='%s', account='%u', deleteDate=NULL, deleteInfos_Name=NULL, deleteInfos_Account=NULL WHERE deleteDate IS NOT NULL AND guid = %u",
         delInfo.name.c_str(), delInfo.accountId, delInfo.lowguid);
+
+    //                                                     0     1      2       3
+    QueryResult* result = CharacterDatabase.PQuery("SELECT race, class, gender, level FROM characters WHERE guid = %u", delInfo.lowguid);
+    if (result)
+    {
+        Field* fields = result->Fetch();
+        sObjectMgr.AddCharacterNameData(ObjectGuid(HIGHGUID_PLAYER, delInfo.lowguid), delInfo.name, delInfo.accountId,
+            fields[0].GetUInt8(), fields[1].GetUInt8(), fields[2].GetUInt8(), fields[3].GetUInt8());
+        delete result;
+    }
 }
 
 /**
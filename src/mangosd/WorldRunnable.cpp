@@ -27,6 +27,7 @@
 #include "Timer.h"
 #include "MapManager.h"
 #include "BattleGroundMgr.h"
+#include "ObjectMgr.h"
 
 #include "Database/DatabaseEnv.h"
 
@@ -88,6 +89,8 @@ void WorldRunnable::run()
 
     MapManager::Instance().UnloadAll();                     // unload all grids (including locked in memory)
 
+    sObjectMgr.SavePendingRespawnTimes();                   // including saved at grids unload
+
     ///- End the database thread
     WorldDatabase.ThreadEnd();                                  // free mySQL thread resources
 }
@@ -22,6 +22,7 @@
 #include <ctime>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 Database::~Database()
 {
@@ -191,6 +192,31 @@ bool Database::DirectPExecute(const char * format,...)
     return DirectExecute(szQuery);
 }
 
+bool Database::ExecuteIdList(const char* prefix, std::vector<uint32> const& ids, const char* suffix, size_t maxIds)
+{
+    bool res = true;
+
+    for (size_t start = 0; start < ids.size(); start += maxIds)
+    {
+        size_t end = std::min(ids.size(), start + maxIds);
+
+        std::ostringstream ss;
+        ss << prefix;
+        for (size_t i = start; i < end; ++i)
+        {
+            if (i != start)
+                ss << ",";
+            ss << ids[i];
+        }
+        ss << suffix;
+
+        if (!Execute(ss.str().c_str()))
+            res = false;
+    }
+
+    return res;
+}
+
 bool Database::CheckRequiredField( char const* table_name, char const* required_name )
 {
     // check required field
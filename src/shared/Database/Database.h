@@ -23,6 +23,8 @@
 #include "Utilities/UnorderedMapSet.h"
 #include "Database/SqlDelayThread.h"
 
+#include <vector>
+
 class SqlTransaction;
 class SqlResultQueue;
 class SqlQueryHolder;
@@ -100,6 +102,10 @@ class MANGOS_DLL_SPEC Database
         virtual bool DirectExecute(const char* sql) = 0;
         bool DirectPExecute(const char *format,...) ATTR_PRINTF(2,3);
 
+        // Execute prefix + "id1,id2,..." + suffix for each part of ids list with up to maxIds ids,
+        // for example ExecuteIdList("DELETE FROM mail WHERE id IN (", ids, ")", 500)
+        bool ExecuteIdList(const char* prefix, std::vector<uint32> const& ids, const char* suffix, size_t maxIds);
+
         // Writes SQL commands to a LOG file (see mangosd.conf "LogSQL")
         bool PExecuteLog(const char *format,...) ATTR_PRINTF(2,3);
 
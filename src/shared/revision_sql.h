@@ -1,6 +1,6 @@
 #ifndef __REVISION_SQL_H__
 #define __REVISION_SQL_H__
  #define REVISION_DB_CHARACTERS "required_10332_02_characters_pet_aura"
- #define REVISION_DB_MANGOS "required_10400_01_mangos_mangos_string"
+ #define REVISION_DB_MANGOS "required_10414_01_mangos_command"
  #define REVISION_DB_REALMD "required_10008_01_realmd_realmd_db_version"
 #endif // __REVISION_SQL_H__
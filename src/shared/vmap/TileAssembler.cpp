@@ -26,6 +26,9 @@
 #include <iomanip>
 #include <sstream>
 #include <iomanip>
+#include <G3D/System.h>
+
+#define VMAP_BUILD_HASHES_FILE "assembler_hashes.txt"
 
 using G3D::Vector3;
 using G3D::AABox;
@@ -39,6 +42,45 @@ template<> struct BoundsTrait<VMAP::ModelSpawn*>
 
 namespace VMAP
 {
+    // FNV-1a, only used for detect changed input data between assembler runs
+    // (64 bit constants built from halves, UI64LIT not available in NO_CORE_FUNCS builds)
+    static const uint64 FNV_OFFSET_BASIS = (uint64(0xcbf29ce4) << 32) | uint64(0x84222325);
+    static const uint64 FNV_PRIME = (uint64(0x00000100) << 32) | uint64(0x000001b3);
+
+    static uint64 hashBytes(uint64 hash, void const* data, size_t len)
+    {
+        uint8 const* bytes = (uint8 const*)data;
+        for (size_t i = 0; i < len; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    // output format is part of every hash, stale files from older assembler versions are rebuilt
+    static uint64 hashStart()
+    {
+        return hashBytes(FNV_OFFSET_BASIS, VMAP_MAGIC, sizeof(VMAP_MAGIC) - 1);
+    }
+
+    // return 0 if file can't be read
+    static uint64 hashFile(std::string const& fname)
+    {
+        FILE *rf = fopen(fname.c_str(), "rb");
+        if (!rf)
+            return 0;
+
+        uint64 hash = hashStart();
+        char buffer[64*1024];
+        size_t len;
+        while ((len = fread(buffer, 1, sizeof(buffer), rf)) > 0)
+            hash = hashBytes(hash, buffer, len);
+
+        fclose(rf);
+        return hash;
+    }
+
     bool readChunk(FILE *rf, char *dest, const char *compare, uint32 len)
     {
         if (fread(dest, sizeof(char), len, rf) != len) return false;
@@ -71,132 +113,368 @@ namespace VMAP
 
     bool TileAssembler::convertWorld2()
     {
-        std::set<std::string> spawnedModelFiles;
+        G3D::RealTime startTime = G3D::System::time();
+        G3D::RealTime stageTime = startTime;
+
         bool success = readMapSpawns();
         if (!success)
             return false;
 
+        printf("Read map spawns: %.2f sec\n", G3D::System::time() - stageTime);
+
+        loadBuildHashes();
+
+        // collect all used model files, spawns data not changed later for already sorted data
+        std::set<std::string> spawnedModelFiles;
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+            for (UniqueEntryMap::iterator entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
+                spawnedModelFiles.insert(entry->second.name);
+
+        std::vector<std::string> modelFiles(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        std::vector<uint64> modelHashes(modelFiles.size(), 0);
+
+        // hash raw model files, used for detect changed models and maps with changed M2 bounds
+        stageTime = G3D::System::time();
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic)
+#endif
+        for (int i = 0; i < int(modelFiles.size()); ++i)
+            modelHashes[i] = hashFile(iSrcDir + "/" + modelFiles[i]);
+
+        BuildHashMap modelHashMap;
+        for (size_t i = 0; i < modelFiles.size(); ++i)
+            modelHashMap[modelFiles[i]] = modelHashes[i];
+
+        printf("Hashed %u raw model files: %.2f sec\n", uint32(modelFiles.size()), G3D::System::time() - stageTime);
+
         // export Map data
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end() && success; ++map_iter)
+        stageTime = G3D::System::time();
+        std::vector<MapData::iterator> maps;
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+            maps.push_back(map_iter);
+
+        int processed = 0, skipped = 0;
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic)
+#endif
+        for (int i = 0; i < int(maps.size()); ++i)
         {
-            // build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            UniqueEntryMap::iterator entry;
-            printf("Calculating model bounds for map %u...\n", map_iter->first);
-            for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
+            uint32 mapId = maps[i]->first;
+            std::stringstream key;
+            key << "map:" << mapId;
+            uint64 hash = calculateMapHash(maps[i]->second, modelHashMap);
+
+            bool upToDate = isUpToDate(key.str(), hash, getMapOutputFileNames(mapId, maps[i]->second));
+            bool result = upToDate || exportMap(mapId, maps[i]->second);
+
+#ifdef _OPENMP
+            #pragma omp critical(tileassembler_state)
+#endif
             {
-                // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
-                if (entry->second.flags & MOD_M2)
-                {
-                    if (!calculateTransformedBound(entry->second))
-                        break;
-                }
-                else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
+                ++processed;
+                if (upToDate)
+                    ++skipped;
+                if (result)
+                    iNewHashes[key.str()] = hash;
+                else
+                    success = false;
+                printf("[%i/%i] Map %03u %s\n", processed, int(maps.size()), mapId, upToDate ? "unchanged, skipped" : (result ? "done" : "FAILED"));
+            }
+        }
+
+        printf("Exported %i maps (%i unchanged): %.2f sec\n", processed - skipped, skipped, G3D::System::time() - stageTime);
+
+        // export objects
+        stageTime = G3D::System::time();
+        std::cout << "\nConverting Model Files" << std::endl;
+        processed = 0;
+        skipped = 0;
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic)
+#endif
+        for (int i = 0; i < int(modelFiles.size()); ++i)
+        {
+            std::string key = "model:" + modelFiles[i];
+
+            bool upToDate = modelHashes[i] && isUpToDate(key, modelHashes[i], std::vector<std::string>(1, iDestDir + "/" + modelFiles[i] + ".vmo"));
+            bool result = upToDate || convertRawFile(modelFiles[i]);
+
+#ifdef _OPENMP
+            #pragma omp critical(tileassembler_state)
+#endif
+            {
+                ++processed;
+                if (upToDate)
+                    ++skipped;
+                if (result)
+                    iNewHashes[key] = modelHashes[i];
+                else
                 {
-                    // TODO: remove extractor hack and uncomment below line:
-                    //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                    entry->second.iBound = entry->second.iBound + Vector3(533.33333f*32, 533.33333f*32, 0.f);
+                    std::cout << "error converting " << modelFiles[i] << std::endl;
+                    success = false;
                 }
-                mapSpawns.push_back(&(entry->second));
-                spawnedModelFiles.insert(entry->second.name);
+                if (!upToDate)
+                    std::cout << "[" << processed << "/" << modelFiles.size() << "] Converted " << modelFiles[i] << std::endl;
             }
+        }
 
-            printf("Creating map tree...\n");
-            BIH pTree;
-            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+        printf("Converted %i model files (%i unchanged): %.2f sec\n", processed - skipped, skipped, G3D::System::time() - stageTime);
 
-            // ===> possibly move this code to StaticMapTree class
-            std::map<uint32, uint32> modelNodeIdx;
-            for (uint32 i=0; i<mapSpawns.size(); ++i)
-                modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+        // store hashes of successfully written data only, failed parts rebuilt at next run
+        if (!saveBuildHashes())
+            success = false;
 
-            // write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << "/" << std::setfill('0') << std::setw(3) << map_iter->first << ".vmtree";
-            FILE *mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
+        printf("Total time: %.2f sec\n", G3D::System::time() - startTime);
+
+        //cleanup:
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        {
+            delete map_iter->second;
+        }
+        return success;
+    }
+
+    bool TileAssembler::exportMap(uint32 mapId, MapSpawns* spawns)
+    {
+        // build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        UniqueEntryMap::iterator entry;
+        for (entry = spawns->UniqueEntries.begin(); entry != spawns->UniqueEntries.end(); ++entry)
+        {
+            // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
+            if (entry->second.flags & MOD_M2)
             {
-                success = false;
-                printf("Cannot open %s\n", mapfilename.str().c_str());
-                break;
+                if (!calculateTransformedBound(entry->second))
+                    break;
             }
-
-            //general info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
-            uint32 globalTileID = StaticMapTree::packTileID(65, 65);
-            pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-            char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
-            if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
-            if (success) success = pTree.writeToFile(mapfile);
-            // global map spawns (WDT), if any (most instances)
-            if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
-
-            for (TileMap::iterator glob=globalRange.first; glob != globalRange.second && success; ++glob)
+            else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
             {
-                success = ModelSpawn::writeToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
+                // TODO: remove extractor hack and uncomment below line:
+                //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
+                entry->second.iBound = entry->second.iBound + Vector3(533.33333f*32, 533.33333f*32, 0.f);
             }
+            mapSpawns.push_back(&(entry->second));
+        }
+
+        BIH pTree;
+        pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
 
-            fclose(mapfile);
+        // ===> possibly move this code to StaticMapTree class
+        std::map<uint32, uint32> modelNodeIdx;
+        for (uint32 i=0; i<mapSpawns.size(); ++i)
+            modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+
+        // write map tree file
+        std::string mapfilename = getMapTreeFileName(mapId);
+        FILE *mapfile = fopen(mapfilename.c_str(), "wb");
+        if (!mapfile)
+        {
+            printf("Cannot open %s\n", mapfilename.c_str());
+            return false;
+        }
 
-            // <====
+        bool success = true;
 
-            // write map tile files, similar to ADT files, only with extra BSP tree node info
-            TileMap &tileEntries = map_iter->second->TileEntries;
-            TileMap::iterator tile;
-            for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        //general info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
+        uint32 globalTileID = StaticMapTree::packTileID(65, 65);
+        pair<TileMap::iterator, TileMap::iterator> globalRange = spawns->TileEntries.equal_range(globalTileID);
+        char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
+        if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
+        if (success) success = pTree.writeToFile(mapfile);
+        // global map spawns (WDT), if any (most instances)
+        if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
+
+        for (TileMap::iterator glob=globalRange.first; glob != globalRange.second && success; ++glob)
+        {
+            success = ModelSpawn::writeToFile(mapfile, spawns->UniqueEntries[glob->second]);
+        }
+
+        fclose(mapfile);
+
+        // <====
+
+        // write map tile files, similar to ADT files, only with extra BSP tree node info
+        TileMap &tileEntries = spawns->TileEntries;
+        TileMap::iterator tile;
+        for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        {
+            const ModelSpawn &spawn = spawns->UniqueEntries[tile->second];
+            if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
+                continue;
+            uint32 nSpawns = tileEntries.count(tile->first);
+            std::string tilefilename = getTileFileName(mapId, tile->first);
+            FILE *tilefile = fopen(tilefilename.c_str(), "wb");
+            if (!tilefile)
             {
-                const ModelSpawn &spawn = map_iter->second->UniqueEntries[tile->second];
-                if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
-                    continue;
-                uint32 nSpawns = tileEntries.count(tile->first);
-                std::stringstream tilefilename;
-                tilefilename.fill('0');
-                tilefilename << iDestDir << "/" << std::setw(3) << map_iter->first << "_";
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tile->first, x, y);
-                tilefilename << std::setw(2) << x << "_" << std::setw(2) << y << ".vmtile";
-                FILE *tilefile = fopen(tilefilename.str().c_str(), "wb");
-                // file header
-                if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
-                // write number of tile spawns
-                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
-                // write tile spawns
-                for (uint32 s=0; s<nSpawns; ++s)
-                {
-                    if (s)
-                        ++tile;
-                    const ModelSpawn &spawn2 = map_iter->second->UniqueEntries[tile->second];
-                    success = success && ModelSpawn::writeToFile(tilefile, spawn2);
-                    // MapTree nodes to update when loading tile:
-                    std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
-                    if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
-                }
-                fclose(tilefile);
+                printf("Cannot open %s\n", tilefilename.c_str());
+                return false;
+            }
+            // file header
+            if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
+            // write number of tile spawns
+            if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
+            // write tile spawns
+            for (uint32 s=0; s<nSpawns; ++s)
+            {
+                if (s)
+                    ++tile;
+                const ModelSpawn &spawn2 = spawns->UniqueEntries[tile->second];
+                success = success && ModelSpawn::writeToFile(tilefile, spawn2);
+                // MapTree nodes to update when loading tile:
+                std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
+                if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
             }
-            // break; //test, extract only first map; TODO: remvoe this line
+            fclose(tilefile);
         }
 
-        // export objects
-        std::cout << "\nConverting Model Files" << std::endl;
-        for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+        return success;
+    }
+
+    std::string TileAssembler::getMapTreeFileName(uint32 mapId) const
+    {
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << "/" << std::setfill('0') << std::setw(3) << mapId << ".vmtree";
+        return mapfilename.str();
+    }
+
+    std::string TileAssembler::getTileFileName(uint32 mapId, uint32 tileId) const
+    {
+        uint32 x, y;
+        StaticMapTree::unpackTileID(tileId, x, y);
+        std::stringstream tilefilename;
+        tilefilename.fill('0');
+        tilefilename << iDestDir << "/" << std::setw(3) << mapId << "_" << std::setw(2) << x << "_" << std::setw(2) << y << ".vmtile";
+        return tilefilename.str();
+    }
+
+    // map tree file and all tile files written by exportMap
+    std::vector<std::string> TileAssembler::getMapOutputFileNames(uint32 mapId, MapSpawns* spawns) const
+    {
+        std::vector<std::string> files;
+        files.push_back(getMapTreeFileName(mapId));
+
+        std::set<uint32> tiles;
+        for (TileMap::const_iterator tile = spawns->TileEntries.begin(); tile != spawns->TileEntries.end(); ++tile)
         {
-            std::cout << "Converting " << *mfile << std::endl;
-            if (!convertRawFile(*mfile))
+            UniqueEntryMap::const_iterator spawn = spawns->UniqueEntries.find(tile->second);
+            if (spawn == spawns->UniqueEntries.end() || (spawn->second.flags & MOD_WORLDSPAWN))
+                continue;
+
+            if (tiles.insert(tile->first).second)
+                files.push_back(getTileFileName(mapId, tile->first));
+        }
+
+        return files;
+    }
+
+    uint64 TileAssembler::calculateMapHash(MapSpawns* spawns, BuildHashMap const& modelHashes) const
+    {
+        uint64 hash = hashStart();
+        for (UniqueEntryMap::const_iterator entry = spawns->UniqueEntries.begin(); entry != spawns->UniqueEntries.end(); ++entry)
+        {
+            ModelSpawn const& spawn = entry->second;
+            hash = hashBytes(hash, &spawn.flags, sizeof(spawn.flags));
+            hash = hashBytes(hash, &spawn.adtId, sizeof(spawn.adtId));
+            hash = hashBytes(hash, &spawn.ID, sizeof(spawn.ID));
+            hash = hashBytes(hash, &spawn.iPos, sizeof(spawn.iPos));
+            hash = hashBytes(hash, &spawn.iRot, sizeof(spawn.iRot));
+            hash = hashBytes(hash, &spawn.iScale, sizeof(spawn.iScale));
+            Vector3 lo = spawn.iBound.low(), hi = spawn.iBound.high();
+            hash = hashBytes(hash, &lo, sizeof(lo));
+            hash = hashBytes(hash, &hi, sizeof(hi));
+            hash = hashBytes(hash, spawn.name.c_str(), spawn.name.size());
+
+            // M2 bounds calculated from model data
+            if (spawn.flags & MOD_M2)
             {
-                std::cout << "error converting " << *mfile << std::endl;
-                success = false;
-                break;
+                BuildHashMap::const_iterator mItr = modelHashes.find(spawn.name);
+                uint64 modelHash = mItr != modelHashes.end() ? mItr->second : 0;
+                hash = hashBytes(hash, &modelHash, sizeof(modelHash));
             }
         }
 
-        //cleanup:
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        for (TileMap::const_iterator tile = spawns->TileEntries.begin(); tile != spawns->TileEntries.end(); ++tile)
         {
-            delete map_iter->second;
+            hash = hashBytes(hash, &tile->first, sizeof(tile->first));
+            hash = hashBytes(hash, &tile->second, sizeof(tile->second));
         }
-        return success;
+
+        return hash;
+    }
+
+    bool TileAssembler::isUpToDate(std::string const& key, uint64 hash, std::vector<std::string> const& outFiles) const
+    {
+        BuildHashMap::const_iterator itr = iPrevHashes.find(key);
+        if (itr == iPrevHashes.end() || itr->second != hash)
+            return false;
+
+        // output can be deleted manually after previous run
+        for (std::vector<std::string>::const_iterator file = outFiles.begin(); file != outFiles.end(); ++file)
+        {
+            FILE *of = fopen(file->c_str(), "rb");
+            if (!of)
+                return false;
+
+            fclose(of);
+        }
+
+        return true;
+    }
+
+    void TileAssembler::loadBuildHashes()
+    {
+        iPrevHashes.clear();
+
+        std::string fname = iDestDir + "/" + VMAP_BUILD_HASHES_FILE;
+        FILE *hf = fopen(fname.c_str(), "rb");
+        if (!hf)
+        {
+            printf("No previous build data found, full rebuild\n");
+            return;
+        }
+
+        char buffer[1024];
+        while (fgets(buffer, sizeof(buffer), hf))
+        {
+            // line format: <hash hex> <key>
+            char *sep = strchr(buffer, ' ');
+            if (!sep)
+                continue;
+
+            *sep = 0;
+            std::string key = sep + 1;
+            while (!key.empty() && (key[key.size()-1] == '\n' || key[key.size()-1] == '\r'))
+                key.erase(key.size()-1);
+
+            uint32 hi = 0, lo = 0;
+            if (strlen(buffer) != 16 || sscanf(buffer, "%8x%8x", &hi, &lo) != 2)
+                continue;
+
+            iPrevHashes[key] = (uint64(hi) << 32) | uint64(lo);
+        }
+        fclose(hf);
+
+        printf("Loaded %u entries of previous build data, unchanged data will be skipped\n", uint32(iPrevHashes.size()));
+    }
+
+    bool TileAssembler::saveBuildHashes() const
+    {
+        std::string fname = iDestDir + "/" + VMAP_BUILD_HASHES_FILE;
+        FILE *hf = fopen(fname.c_str(), "wb");
+        if (!hf)
+        {
+            printf("Cannot open %s\n", fname.c_str());
+            return false;
+        }
+
+        for (BuildHashMap::const_iterator itr = iNewHashes.begin(); itr != iNewHashes.end(); ++itr)
+            fprintf(hf, "%08x%08x %s\n", uint32(itr->second >> 32), uint32(itr->second), itr->first.c_str());
+
+        fclose(hf);
+        return true;
     }
 
     bool TileAssembler::readMapSpawns()
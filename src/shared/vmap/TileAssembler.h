@@ -22,6 +22,7 @@
 #include <G3D/Vector3.h>
 #include <G3D/Matrix3.h>
 #include <map>
+#include <vector>
 
 #include "ModelInstance.h"
 
@@ -59,6 +60,9 @@ namespace VMAP
     };
 
     typedef std::map<uint32, MapSpawns*> MapData;
+
+    // content hashes of previous build, used for skip unchanged maps and models at incremental rebuild
+    typedef std::map<std::string, uint64> BuildHashMap;
     //===============================================
 
     class TileAssembler
@@ -70,6 +74,17 @@ namespace VMAP
             G3D::Table<std::string, unsigned int > iUniqueNameIds;
             unsigned int iCurrentUniqueNameId;
             MapData mapData;
+            BuildHashMap iPrevHashes;
+            BuildHashMap iNewHashes;
+
+            bool exportMap(uint32 mapId, MapSpawns* spawns);
+            std::string getMapTreeFileName(uint32 mapId) const;
+            std::string getTileFileName(uint32 mapId, uint32 tileId) const;
+            std::vector<std::string> getMapOutputFileNames(uint32 mapId, MapSpawns* spawns) const;
+            uint64 calculateMapHash(MapSpawns* spawns, BuildHashMap const& modelHashes) const;
+            bool isUpToDate(std::string const& key, uint64 hash, std::vector<std::string> const& outFiles) const;
+            void loadBuildHashes();
+            bool saveBuildHashes() const;
 
         public:
             TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);